@@ -85,11 +85,19 @@ COMPILER_WORD_ALIGNED
 //! To store current protocol of HID generic
 COMPILER_WORD_ALIGNED
 		static uint8_t udi_hid_generic_protocol;
-//! To signal if the report IN buffer is free (no transfer on going)
-static bool udi_hid_generic_b_report_in_free;
-//! Report to send
+//! Reports to send: one in transfer, one committed and waiting, one written by the application.
+//! Only one is ever handed to the hardware, even on a ping-pong endpoint:
+//! a staged bank can't be replaced any more, newer reports wait in the pending slot.
+#define  UDI_HID_GENERIC_REPORT_IN_NB  3
+#define  UDI_HID_GENERIC_REPORT_IN_NONE  0xFF
 COMPILER_WORD_ALIGNED
-		static uint8_t udi_hid_generic_report_in[UDI_HID_REPORT_IN_SIZE];
+		static uint8_t udi_hid_generic_report_in[UDI_HID_GENERIC_REPORT_IN_NB][UDI_HID_REPORT_IN_SIZE];
+//! Index of the report in transfer, or UDI_HID_GENERIC_REPORT_IN_NONE
+static volatile uint8_t udi_hid_generic_report_in_sending;
+//! Index of the report committed but waiting for the on going transfer, or UDI_HID_GENERIC_REPORT_IN_NONE
+static volatile uint8_t udi_hid_generic_report_in_pending;
+//! Index of the report the application writes, never one of the two above
+static volatile uint8_t udi_hid_generic_report_in_write;
 //! Report to receive
 // COMPILER_WORD_ALIGNED
 // 		static uint8_t udi_hid_generic_report_out[UDI_HID_REPORT_OUT_SIZE];
@@ -109,11 +117,49 @@ UDC_DESC_STORAGE udi_hid_generic_report_desc_t udi_hid_generic_report_desc = { {
 		0x09, 0x30, 		/* Usage (X)					*/
 		0x09, 0x31,			/* Usage (Y)					*/
 		0x15, 0x00,			/* Logical Minimum (0)			*/
+		0x27, 0xFF, 0xFF, 0x00, 0x00,	/* Logical Maximum (65535)	*/
+		0x75, 0x10,			/* Report Size (16 bits)		*/
+		0x95, 0x02,			/* Report Count (2 → X & Y)		*/
+		0x81, 0x02,			/* Input (Data,Var,Abs)			*/
+		0x09, 0x40,			/* Usage (Vx)					*/
+		0x09, 0x41,			/* Usage (Vy)					*/
+		0x16, 0x00, 0x80,	/* Logical Minimum (-32768)		*/
+		0x26, 0xFF, 0x7F,	/* Logical Maximum (32767)		*/
+		0x95, 0x02,			/* Report Count (2)				*/
+		0x81, 0x02,			/* Input (Data,Var,Abs)			*/
+		0x06, 0x00, 0xFF,	/* Usage Page (Vendor Defined)	*/
+		0x09, 0x01,			/* Usage (X acceleration)		*/
+		0x09, 0x02,			/* Usage (Y acceleration)		*/
+		0x95, 0x02,			/* Report Count (2)				*/
+		0x81, 0x02,			/* Input (Data,Var,Abs)			*/
+		0x09, 0x03,			/* Usage (X contact count)		*/
+		0x09, 0x04,			/* Usage (Y contact count)		*/
+		0x09, 0x05,			/* Usage (X second contact)		*/
+		0x09, 0x06,			/* Usage (Y second contact)		*/
+		0x15, 0x00,			/* Logical Minimum (0)			*/
 		0x26, 0xFF, 0x00,	/* Logical Maximum (255)		*/
 		0x75, 0x08,			/* Report Size (8 bits)			*/
-		0x95, 0x02,			/* Report Count (2 → X & Y)		*/
+		0x95, 0x04,			/* Report Count (4)				*/
+		0x81, 0x02,			/* Input (Data,Var,Abs)			*/
+		0x05, 0x09,			/* Usage Page (Button)			*/
+		0x19, 0x01,			/* Usage Minimum (Button 1)		*/
+		0x29, 0x14,			/* Usage Maximum (Button 20)	*/
+		0x15, 0x00,			/* Logical Minimum (0)			*/
+		0x25, 0x01,			/* Logical Maximum (1)			*/
+		0x75, 0x01,			/* Report Size (1 bit)			*/
+		0x95, 0x14,			/* Report Count (20 → keypad)	*/
 		0x81, 0x02,			/* Input (Data,Var,Abs)			*/
+		0x75, 0x04,			/* Report Size (4 bits)			*/
+		0x95, 0x01,			/* Report Count (1)				*/
+		0x81, 0x03,			/* Input (Const) → byte padding	*/
 	  0xC0,					/* End Collection				*/
+	  0x06, 0x00, 0xFF,		/* Usage Page (Vendor Defined)	*/
+	  0x09, 0x10,			/* Usage (Host command)			*/
+	  0x15, 0x00,			/* Logical Minimum (0)			*/
+	  0x26, 0xFF, 0x00,		/* Logical Maximum (255)		*/
+	  0x75, 0x08,			/* Report Size (8 bits)			*/
+	  0x95, UDI_HID_REPORT_FEATURE_SIZE,	/* Report Count (see feature.h)	*/
+	  0xB1, 0x02,			/* Feature (Data,Var,Abs)		*/
 	0xC0					/* End Collection				*/
 		}
 };	// array modified by UniWest
@@ -161,6 +207,16 @@ static void udi_hid_generic_setfeature_valid(void);
 static void udi_hid_generic_report_in_sent(udd_ep_status_t status,
 		iram_size_t nb_sent, udd_ep_id_t ep);
 
+/**
+ * \brief Starts the transfer of the pending report
+ *
+ * Called with interrupts disabled or from the completion callback,
+ * only while no report is in transfer.
+ *
+ * \return \c 1 if the report was started, otherwise \c 0 (the report is dropped).
+ */
+static bool udi_hid_generic_report_in_arm(void);
+
 //@}
 
 
@@ -172,7 +228,9 @@ bool udi_hid_generic_enable(void)
 	// Initialize internal values
 	udi_hid_generic_rate = 0;
 	udi_hid_generic_protocol = 0;
-	udi_hid_generic_b_report_in_free = true;
+	udi_hid_generic_report_in_sending = UDI_HID_GENERIC_REPORT_IN_NONE;
+	udi_hid_generic_report_in_pending = UDI_HID_GENERIC_REPORT_IN_NONE;
+	udi_hid_generic_report_in_write = 0;
 	// if (!udi_hid_generic_report_out_enable())
 	// 	return false;
 	return UDI_HID_GENERIC_ENABLE_EXT();
@@ -222,23 +280,49 @@ static bool udi_hid_generic_setreport(void)
 
 bool udi_hid_generic_send_report_in(uint8_t *data)
 {
-	if (!udi_hid_generic_b_report_in_free)
+	if (udi_hid_generic_report_in_pending != UDI_HID_GENERIC_REPORT_IN_NONE
+			|| udi_hid_generic_report_in_sending != UDI_HID_GENERIC_REPORT_IN_NONE)
 		return false;
+	memcpy(udi_hid_generic_acquire_report_in(), data,
+			UDI_HID_REPORT_IN_SIZE);
+	return udi_hid_generic_commit_report_in(true);
+}
+
+bool udi_hid_generic_post_report_in(uint8_t *data)
+{
+	memcpy(udi_hid_generic_acquire_report_in(), data,
+			UDI_HID_REPORT_IN_SIZE);
+	return udi_hid_generic_commit_report_in(true);
+}
+
+uint8_t *udi_hid_generic_acquire_report_in(void)
+{
+	// Neither in transfer nor pending, only a commit hands it over
+	return udi_hid_generic_report_in[udi_hid_generic_report_in_write];
+}
+
+bool udi_hid_generic_commit_report_in(bool b_send)
+{
+	if (!b_send)
+		return true;	// The buffer is simply written again by the next acquire
+	bool b_ok = true;
 	irqflags_t flags = cpu_irq_save();
-	// Fill report
-	memset(&udi_hid_generic_report_in, 0,
-			sizeof(udi_hid_generic_report_in));
-	memcpy(&udi_hid_generic_report_in, data,
-	      		sizeof(udi_hid_generic_report_in));
-	udi_hid_generic_b_report_in_free =
-			!udd_ep_run(UDI_HID_GENERIC_EP_IN,
-							false,
-							(uint8_t *) & udi_hid_generic_report_in,
-							sizeof(udi_hid_generic_report_in),
-							udi_hid_generic_report_in_sent);
+	uint8_t sending = udi_hid_generic_report_in_sending;
+	uint8_t pending = udi_hid_generic_report_in_pending;
+	udi_hid_generic_report_in_pending = udi_hid_generic_report_in_write;	// Latest wins
+	if (pending == UDI_HID_GENERIC_REPORT_IN_NONE) {
+		// Take the slot neither in transfer nor just committed
+		pending = udi_hid_generic_report_in_write;
+		do {
+			if (++pending == UDI_HID_GENERIC_REPORT_IN_NB)
+				pending = 0;
+		} while (pending == sending);
+	}
+	udi_hid_generic_report_in_write = pending;	// The replaced report is written next
+	if (sending == UDI_HID_GENERIC_REPORT_IN_NONE)
+		b_ok = udi_hid_generic_report_in_arm();
 	cpu_irq_restore(flags);
-	return !udi_hid_generic_b_report_in_free;
-
+	return b_ok;
 }
 
 //--------------------------------------------
@@ -248,7 +332,7 @@ static void udi_hid_generic_setfeature_valid(void)
 {
 	if (sizeof(udi_hid_generic_report_feature) != udd_g_ctrlreq.payload_size)
 		return;	// Bad data
-	// UDI_HID_GENERIC_SET_FEATURE(udi_hid_generic_report_feature);
+	UDI_HID_GENERIC_SET_FEATURE(udi_hid_generic_report_feature);
 }
 
 // static void udi_hid_generic_report_out_received(udd_ep_status_t status,
@@ -278,10 +362,38 @@ static void udi_hid_generic_setfeature_valid(void)
 static void udi_hid_generic_report_in_sent(udd_ep_status_t status,
 		iram_size_t nb_sent, udd_ep_id_t ep)
 {
-	UNUSED(status);
 	UNUSED(nb_sent);
 	UNUSED(ep);
-	udi_hid_generic_b_report_in_free = true;
+	udi_hid_generic_report_in_sending = UDI_HID_GENERIC_REPORT_IN_NONE;
+	if (status != UDD_EP_TRANSFER_OK) {
+		// Aborted, drop the committed report too
+		udi_hid_generic_report_in_pending = UDI_HID_GENERIC_REPORT_IN_NONE;
+		return;
+	}
+#ifdef UDI_HID_GENERIC_REPORT_IN_SENT
+	UDI_HID_GENERIC_REPORT_IN_SENT();
+#endif
+	// Arm the pending report right away, it doesn't wait for the next frame.
+	// The application writes another buffer meanwhile.
+	if (udi_hid_generic_report_in_pending != UDI_HID_GENERIC_REPORT_IN_NONE)
+		udi_hid_generic_report_in_arm();
+}
+
+static bool udi_hid_generic_report_in_arm(void)
+{
+	uint8_t pending = udi_hid_generic_report_in_pending;
+	udi_hid_generic_report_in_pending = UDI_HID_GENERIC_REPORT_IN_NONE;
+	udi_hid_generic_report_in_sending = pending;
+	if (!udd_ep_run(UDI_HID_GENERIC_EP_IN,
+							false,
+							udi_hid_generic_report_in[pending],
+							UDI_HID_REPORT_IN_SIZE,
+							udi_hid_generic_report_in_sent)) {
+		// Halted or not enabled, nothing will complete: drop it, the next commit retries
+		udi_hid_generic_report_in_sending = UDI_HID_GENERIC_REPORT_IN_NONE;
+		return false;
+	}
+	return true;
 }
 
 //@}
@@ -75,7 +75,7 @@ typedef struct {
 
 //! Report descriptor for HID generic
 typedef struct {
-	uint8_t array[27]; // changed from 53 -> 27
+	uint8_t array[111]; // changed from 53 -> 111
 } udi_hid_generic_report_desc_t;
 
 
@@ -84,6 +84,11 @@ typedef struct {
 #define UDI_HID_GENERIC_STRING_ID 0
 #endif
 
+//! Interrupt IN polling interval in ms, patched at run time by udi_hid_generic_set_interval()
+#ifndef UDI_HID_GENERIC_EP_INTERVAL
+#define UDI_HID_GENERIC_EP_INTERVAL 4
+#endif
+
 
 
 //! Content of HID generic interface descriptor for all speed
@@ -109,7 +114,7 @@ typedef struct {
    .ep_in.bEndpointAddress    = UDI_HID_GENERIC_EP_IN,\
    .ep_in.bmAttributes        = USB_EP_TYPE_INTERRUPT,\
    .ep_in.wMaxPacketSize      = LE16(UDI_HID_GENERIC_EP_SIZE),\
-   .ep_in.bInterval           = 4,\
+   .ep_in.bInterval           = UDI_HID_GENERIC_EP_INTERVAL,\
    }
 //@}
 
@@ -133,6 +138,54 @@ typedef struct {
  */
 bool udi_hid_generic_send_report_in(uint8_t *data);
 
+/**
+ * \brief Routine used to post the latest report to USB Host
+ *
+ * Unlike udi_hid_generic_send_report_in(), a report posted while a transfer
+ * is on going is kept in a single slot mailbox (a newer one replaces it)
+ * and sent as soon as the transfer completes.
+ *
+ * \param data     Pointer on the report to send (size = UDI_HID_REPORT_IN_SIZE)
+ *
+ * \return \c 1 if the report was sent or queued, \c 0 if the endpoint is not enabled.
+ */
+bool udi_hid_generic_post_report_in(uint8_t *data);
+
+/**
+ * \brief Hands out the report buffer that is sent next (zero copy)
+ *
+ * Reports are triple buffered, the returned buffer is never in transfer nor
+ * committed and waiting, so writing it can't change a queued report.
+ * It holds an older report, so all bytes must be written.
+ * Each acquire must be followed by udi_hid_generic_commit_report_in().
+ *
+ * \return Pointer on the report (size = UDI_HID_REPORT_IN_SIZE)
+ */
+uint8_t *udi_hid_generic_acquire_report_in(void);
+
+/**
+ * \brief Gives the acquired report buffer back
+ *
+ * With \a b_send, the report is sent now if no transfer is on going,
+ * otherwise as soon as it completes (latest wins, as the mailbox).
+ * Without, the buffer is dropped and handed out again by the next acquire,
+ * a report committed earlier is not touched.
+ *
+ * \param b_send   true to send the report
+ *
+ * \return \c 1 if the report was sent or queued, \c 0 if the endpoint is not enabled.
+ */
+bool udi_hid_generic_commit_report_in(bool b_send);
+
+/**
+ * \brief Changes bInterval in the configuration descriptor (RAM)
+ *
+ * Takes effect when the host enumerates the device the next time.
+ *
+ * \param interval  Polling interval in ms (1..255 at full speed)
+ */
+void udi_hid_generic_set_interval(uint8_t interval);
+
 //@}
 
 
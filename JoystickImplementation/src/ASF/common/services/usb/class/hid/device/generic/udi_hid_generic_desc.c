@@ -126,6 +126,11 @@ UDC_DESC_STORAGE udc_desc_t udc_desc = {
 	.hid_generic               = UDI_HID_GENERIC_DESC,
 };
 
+void udi_hid_generic_set_interval(uint8_t interval)
+{
+	udc_desc.hid_generic.ep_in.bInterval = interval;
+}
+
 
 /**
  * \name UDC structures which contains all USB Device definitions
@@ -342,6 +342,8 @@ typedef struct {
 	uint8_t b_shortpacket:1;
 	//! The cache buffer is currently used on endpoint OUT
 	uint8_t b_use_out_cache_buffer:1;
+	//! Bank loaded by this job on a ping-pong endpoint IN
+	uint8_t bank:1;
 	//! Buffer located in internal RAM to send or fill during job
 	uint8_t *buf;
 	//! Size of buffer to send or fill
@@ -359,6 +361,46 @@ typedef struct {
 //! Array to register a job on bulk/interrupt/isochronous endpoint
 static udd_ep_job_t udd_ep_job[USB_DEVICE_MAX_EP * 2];
 
+#ifdef UDD_EP_PINGPONG_IN
+/**
+ * \brief Second job of the ping-pong endpoints IN
+ *
+ * Endpoints IN listed in UDD_EP_PINGPONG_IN (bit mask of endpoint numbers)
+ * use the OUT descriptor of the same number as second bank, so the next
+ * transfer is staged while the previous one waits for the IN token.
+ * The OUT endpoint of that number is not available then, and each job
+ * is limited to one packet.
+ * udd_ep_job[] holds the job completing first, udd_ep_job_next[] the next.
+ */
+static udd_ep_job_t udd_ep_job_next[USB_DEVICE_MAX_EP];
+
+//! Bank loaded by the next job of each ping-pong endpoint
+static uint8_t udd_ep_pingpong_bank[USB_DEVICE_MAX_EP];
+
+/**
+ * \brief Registers a one packet job on a ping-pong endpoint IN
+ *
+ * \return \c 1 if the job is loaded in a bank, \c 0 if both banks are busy
+ * or the job does not fit one packet.
+ */
+static bool udd_ep_pingpong_run(udd_ep_id_t ep, bool b_shortpacket,
+		uint8_t * buf, iram_size_t buf_size, udd_callback_trans_t callback);
+
+/**
+ * \brief Manages transfer complete on both banks of a ping-pong endpoint IN
+ *
+ * \param ep   endpoint number to manage
+ */
+static void udd_ep_pingpong_complet(udd_ep_id_t ep);
+
+/**
+ * \brief Aborts the jobs of both banks of a ping-pong endpoint IN
+ *
+ * \param ep   endpoint number to abort
+ */
+static void udd_ep_pingpong_abort(udd_ep_id_t ep);
+#endif
+
 /**
  * \brief Buffer to store the data received on bulk/interrupt endpoints
  *
@@ -459,6 +501,11 @@ void udd_enable(void)
 	for (i = 0; i < (USB_DEVICE_MAX_EP * 2); i++) {
 		udd_ep_job[i].busy = false;
 	}
+#  ifdef UDD_EP_PINGPONG_IN
+	for (i = 0; i < USB_DEVICE_MAX_EP; i++) {
+		udd_ep_job_next[i].busy = false;
+	}
+#  endif
 #endif
 
 	//** Enable USB hardware
@@ -592,6 +639,21 @@ bool udd_ep_alloc(udd_ep_id_t ep, uint8_t bmAttributes,
 	if (udd_endpoint_is_enable(ep_ctrl)) {
 		return false; // Already allocated
 	}
+#ifdef UDD_EP_PINGPONG_IN
+	if (UDD_EP_PINGPONG_IN & (1 << (ep & USB_EP_ADDR_MASK))) {
+		if (USB_EP_DIR_IN != (ep & USB_EP_DIR_IN)) {
+			return false; // Used as second bank of the endpoint IN
+		}
+		if ((bmAttributes & USB_EP_TYPE_MASK) != USB_EP_TYPE_ISOCHRONOUS) {
+			udd_ep_init(ep, bmAttributes, MaxEndpointSize);
+			// The OUT descriptor of this number is bank 1, no multipacket
+			udd_endpoint_clear_status(udd_ep_get_ctrl(ep & USB_EP_ADDR_MASK));
+			udd_ep_pingpong_bank[(ep & USB_EP_ADDR_MASK) - 1] = 0;
+			udd_endpoint_set_pingpong(ep_ctrl);
+			return true;
+		}
+	}
+#endif
 	udd_ep_init(ep, bmAttributes, MaxEndpointSize);
 
 	// Do not use multipacket mode with isochronous 1023 bytes endpoint
@@ -679,6 +741,12 @@ bool udd_ep_run(udd_ep_id_t ep, bool b_shortpacket, uint8_t * buf,
 		&& udd_endpoint_is_stall(ep_ctrl)) {
 		return false; // Endpoint is halted
 	}
+#ifdef UDD_EP_PINGPONG_IN
+	if (udd_endpoint_is_pingpong(ep_ctrl)) {
+		return udd_ep_pingpong_run(ep, b_shortpacket, buf, buf_size,
+				callback);
+	}
+#endif
 	flags = cpu_irq_save();
 	if (ptr_job->busy == true) {
 		cpu_irq_restore(flags);
@@ -726,6 +794,12 @@ void udd_ep_abort(udd_ep_id_t ep)
 	ep_ctrl = udd_ep_get_ctrl(ep);
 	ptr_job = udd_ep_get_job(ep);
 
+#ifdef UDD_EP_PINGPONG_IN
+	if (udd_endpoint_is_pingpong(ep_ctrl)) {
+		udd_ep_pingpong_abort(ep);
+		return;
+	}
+#endif
 	// Stop transfer
 	udd_endpoint_set_NACK0(ep_ctrl);
 	if (ptr_job->busy == false) {
@@ -879,6 +953,15 @@ ISR(USB_TRNCOMPL_vect)
 	ep = (ep_index / 2) + ((ep_index & 1) ? USB_EP_DIR_IN : 0);
 	Assert(USB_DEVICE_MAX_EP >= (ep & USB_EP_ADDR_MASK));
 
+#ifdef UDD_EP_PINGPONG_IN
+	// The FIFO can point at either bank, both belong to the endpoint IN
+	if ((ep & USB_EP_ADDR_MASK) && udd_endpoint_is_pingpong(
+			udd_ep_get_ctrl(ep | USB_EP_DIR_IN))) {
+		udd_ep_pingpong_complet(ep | USB_EP_DIR_IN);
+		goto udd_interrupt_tc_end;
+	}
+#endif
+
 	// Ack IT TC of endpoint
 	ep_ctrl = udd_ep_get_ctrl(ep);
 	if (!udd_endpoint_transfer_complete(ep_ctrl)) {
@@ -1446,5 +1529,127 @@ static void udd_ep_trans_complet(udd_ep_id_t ep)
 	}
 	return;
 }
+
+#ifdef UDD_EP_PINGPONG_IN
+static bool udd_ep_pingpong_run(udd_ep_id_t ep, bool b_shortpacket,
+		uint8_t * buf, iram_size_t buf_size, udd_callback_trans_t callback)
+{
+	udd_ep_job_t *ptr_job;
+	UDD_EP_t *ep_ctrl, *bank_ctrl;
+	uint8_t i = (ep & USB_EP_ADDR_MASK) - 1;
+	uint16_t ep_size;
+	irqflags_t flags;
+
+	ep_ctrl = udd_ep_get_ctrl(ep);
+	ep_size = udd_ep_get_size(ep_ctrl);
+	if ((buf_size > ep_size) || (b_shortpacket && (buf_size == ep_size))) {
+		return false; // One packet per bank, no ZLP after a full packet
+	}
+
+	flags = cpu_irq_save();
+	ptr_job = udd_ep_get_job(ep);
+	if (ptr_job->busy == true) {
+		ptr_job = &udd_ep_job_next[i];
+		if (ptr_job->busy == true) {
+			cpu_irq_restore(flags);
+			return false; // Both banks loaded
+		}
+	}
+	ptr_job->busy = true;
+	ptr_job->buf = buf;
+	ptr_job->buf_size = buf_size;
+	ptr_job->nb_trans = 0;
+	ptr_job->call_trans = callback;
+	ptr_job->b_shortpacket = false;
+	ptr_job->b_use_out_cache_buffer = false;
+	// The host takes the banks in turn, so they are loaded in turn
+	ptr_job->bank = udd_ep_pingpong_bank[i];
+	udd_ep_pingpong_bank[i] ^= 1;
+
+	// Bank 1 uses the data fields of the OUT descriptor
+	bank_ctrl = ptr_job->bank ? udd_ep_get_ctrl(ep & USB_EP_ADDR_MASK)
+			: ep_ctrl;
+	udd_endpoint_in_reset_nb_sent(bank_ctrl);
+	udd_endpoint_in_set_bytecnt(bank_ctrl, buf_size);
+	udd_endpoint_set_buf(bank_ctrl, buf);
+	if (ptr_job->bank) {
+		udd_endpoint_clear_NACK1(ep_ctrl);
+	} else {
+		udd_endpoint_clear_NACK0(ep_ctrl);
+	}
+	cpu_irq_restore(flags);
+	return true;
+}
+
+static void udd_ep_pingpong_complet(udd_ep_id_t ep)
+{
+	UDD_EP_t *ep_ctrl;
+	udd_ep_job_t *ptr_job, *ptr_next;
+	udd_ep_job_t job;
+
+	ep_ctrl = udd_ep_get_ctrl(ep);
+	ptr_job = udd_ep_get_job(ep);
+	ptr_next = &udd_ep_job_next[(ep & USB_EP_ADDR_MASK) - 1];
+
+	// Banks complete in the order they were loaded
+	while (ptr_job->busy) {
+		if (ptr_job->bank) {
+			if (!udd_endpoint_transfer_complete_bank1(ep_ctrl)) {
+				return;
+			}
+			udd_endpoint_ack_transfer_complete_bank1(ep_ctrl);
+		} else {
+			if (!udd_endpoint_transfer_complete_bank0(ep_ctrl)) {
+				return;
+			}
+			udd_endpoint_ack_transfer_complete_bankO(ep_ctrl);
+		}
+		// The staged job moves up before the callback can stage another
+		job = *ptr_job;
+		*ptr_job = *ptr_next;
+		ptr_next->busy = false;
+		if (NULL != job.call_trans) {
+			job.call_trans(UDD_EP_TRANSFER_OK, job.buf_size, ep);
+		}
+	}
+	// No job registered, drop a left over flag
+	udd_endpoint_ack_transfer_complete_bankO(ep_ctrl);
+	udd_endpoint_ack_transfer_complete_bank1(ep_ctrl);
+}
+
+static void udd_ep_pingpong_abort(udd_ep_id_t ep)
+{
+	UDD_EP_t *ep_ctrl;
+	udd_ep_job_t *ptr_job, *ptr_next;
+	udd_ep_job_t job[2];
+	uint8_t i = (ep & USB_EP_ADDR_MASK) - 1;
+	irqflags_t flags;
+
+	ep_ctrl = udd_ep_get_ctrl(ep);
+	ptr_job = udd_ep_get_job(ep);
+	ptr_next = &udd_ep_job_next[i];
+
+	// Stop transfer on both banks and restart from bank 0
+	flags = cpu_irq_save();
+	udd_endpoint_set_NACK0(ep_ctrl);
+	udd_endpoint_set_NACK1(ep_ctrl);
+	udd_endpoint_ack_transfer_complete_bankO(ep_ctrl);
+	udd_endpoint_ack_transfer_complete_bank1(ep_ctrl);
+	udd_endpoint_clear_bank(ep_ctrl);
+	udd_ep_pingpong_bank[i] = 0;
+	job[0] = *ptr_job;
+	job[1] = *ptr_next;
+	ptr_job->busy = false;
+	ptr_next->busy = false;
+	cpu_irq_restore(flags);
+
+	for (i = 0; i < 2; i++) {
+		if (job[i].busy && (NULL != job[i].call_trans)) {
+			job[i].call_trans(UDD_EP_TRANSFER_ABORT, 0, ep);
+		}
+	}
+}
+#endif
+
 #endif // (0!=USB_DEVICE_MAX_EP)
 //@}
@@ -259,6 +259,7 @@ static inline void usb_pad_init(void)
 #define  udd_endpoint_set_multipacket(ep_ctrl)            (ep_ctrl->CTRL |= USB_EP_MULTIPKT_bm)
 #define  udd_endpoint_TC_int_disable(ep_ctrl)             (ep_ctrl->CTRL |= USB_EP_INTDSBL_bm)
 #define  udd_endpoint_set_pingpong(ep_ctrl)               (ep_ctrl->CTRL |= USB_EP_PINGPONG_bm)
+#define  udd_endpoint_is_pingpong(ep_ctrl)                (ep_ctrl->CTRL & USB_EP_PINGPONG_bm ? true : false)
 #define  udd_endpoint_get_size_field(ep_ctrl)             (ep_ctrl->CTRL & USB_EP_BUFSIZE_gm)
 #define  udd_endpoint_get_type(ep_ctrl)                   (ep_ctrl->CTRL & USB_EP_TYPE_gm)
 
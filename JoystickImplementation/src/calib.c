@@ -0,0 +1,69 @@
+// calib.c
+#include <asf.h>
+#include "calib.h"
+#include "joystick.h"
+#include "conf_joystick.h"
+
+int8_t calib_pos[CALIB_AXES][CALIB_POSITIONS + 1];
+uint16_t calib_axis[CALIB_AXES][CALIB_POSITIONS + 1];
+
+// linear default for the 23 half-pad slider positions
+static const uint16_t calib_linear[CALIB_POSITIONS] = {
+        0,  2979,  5958,  8937, 11915, 14894,
+    17873, 20852, 23831, 26810, 29789, 32768,
+    35746, 38725, 41704, 44683, 47662, 50641,
+    53620, 56598, 59577, 62556, 65535
+};
+
+static uint8_t calib_sum(const calib_t *c) {
+    const uint8_t *p = (const uint8_t *)c;
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < offsetof(calib_t, sum); i++)
+        sum += p[i];
+    return (uint8_t)-sum;
+}
+
+static bool calib_valid(const calib_t *c) {
+    return c->magic == CALIB_MAGIC && c->version == CALIB_VERSION && c->sum == calib_sum(c);
+}
+
+void calib_defaults(calib_t *c) {
+    c->magic = CALIB_MAGIC;
+    c->version = CALIB_VERSION;
+    for (uint8_t a = 0; a < CALIB_AXES; a++) {
+        c->axis[a].invert = 0;
+        c->axis[a].center = 0;
+        for (uint8_t p = 0; p < CALIB_POSITIONS; p++)
+            c->axis[a].value[p] = calib_linear[p];
+    }
+    c->sum = calib_sum(c);
+}
+
+void calib_apply(const calib_t *c) {
+    for (uint8_t a = 0; a < CALIB_AXES; a++) {
+        const calib_axis_t *ax = &c->axis[a];
+        calib_pos[a][0] = -1;                           // no contact stays no contact
+        calib_axis[a][0] = JSTK_AXIS_CENTER;
+        for (uint8_t p = 0; p < CALIB_POSITIONS; p++) {
+            calib_pos[a][p + 1] = ax->invert ? (int8_t)(DECODE_POS_MAX - p) : (int8_t)p;
+            int32_t v = (int32_t)ax->value[p] + ax->center;
+            calib_axis[a][p + 1] = (v < 0) ? 0 : (v > 0xFFFF) ? 0xFFFF : (uint16_t)v;
+        }
+    }
+}
+
+void calib_init(void) {
+    calib_t c;
+    nvm_eeprom_read_buffer(CONF_CALIB_EEPROM_ADDR, &c, sizeof(c));
+    if (!calib_valid(&c))
+        calib_defaults(&c);         // blank part, keep the EEPROM untouched until calibrated
+    calib_apply(&c);
+}
+
+void calib_save(calib_t *c) {
+    c->magic = CALIB_MAGIC;
+    c->version = CALIB_VERSION;
+    c->sum = calib_sum(c);
+    nvm_eeprom_erase_and_write_buffer(CONF_CALIB_EEPROM_ADDR, c, sizeof(*c));
+    calib_apply(c);
+}
@@ -0,0 +1,53 @@
+#ifndef CALIB_H
+#define CALIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "decode.h"
+
+/*
+ * Per-unit slider calibration.
+ * Stored in EEPROM (CONF_CALIB_EEPROM_ADDR) and turned into RAM lookup tables once at boot,
+ * so the sample path only does table lookups. Both tables are indexed by half-pad position + 1,
+ * entry 0 is "no contact", which keeps the -1 case free of branches as well.
+ *   calib_pos[]   raw decoded position -> oriented position (inversion)
+ *   calib_axis[]  oriented position    -> axis value (per-position values + center offset)
+ * A blank or corrupt EEPROM falls back to the linear, non-inverted defaults.
+ */
+
+enum { CALIB_HORI, CALIB_VERT, CALIB_AXES };   // X, Y
+
+#define CALIB_POSITIONS     (DECODE_POS_MAX + 1)
+#define CALIB_MAGIC         0xCA1B
+#define CALIB_VERSION       1
+
+typedef struct {
+    uint8_t invert;                         // 1 = pad 0 is at the far end of this panel
+    int16_t center;                         // added to every axis value (saturated)
+    uint16_t value[CALIB_POSITIONS];        // axis value of each oriented half-pad position
+} calib_axis_t;
+
+typedef struct {
+    uint16_t magic;
+    uint8_t version;
+    calib_axis_t axis[CALIB_AXES];
+    uint8_t sum;                            // all bytes before it add up to 0 with it
+} calib_t;
+
+extern int8_t calib_pos[CALIB_AXES][CALIB_POSITIONS + 1];
+extern uint16_t calib_axis[CALIB_AXES][CALIB_POSITIONS + 1];
+
+void calib_init(void);                      // load from EEPROM, defaults if invalid
+void calib_defaults(calib_t *c);
+void calib_apply(const calib_t *c);         // rebuild the RAM tables
+void calib_save(calib_t *c);                // seal, write to EEPROM (blocks a few ms) and apply
+
+static inline int8_t calib_orient(uint8_t axis, int8_t pos) {
+    return calib_pos[axis][pos + 1];
+}
+
+static inline uint16_t calib_toAxis(uint8_t axis, int8_t pos) {
+    return calib_axis[axis][pos + 1];
+}
+
+#endif // CALIB_H
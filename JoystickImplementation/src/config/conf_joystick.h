@@ -0,0 +1,172 @@
+/*
+ * Joystick / front panel configuration
+ *
+ * Build-time defaults for the slider acquisition and report pipeline.
+ * Values can be overridden from the project symbols (-D) if needed.
+ */
+#ifndef CONF_JOYSTICK_H
+#define CONF_JOYSTICK_H
+
+//! Slider acquisition mode at full scan rate (see sense.h)
+//! SENSE_MODE_POLL      - read the slider ports every frame
+//! SENSE_MODE_PINCHANGE - pin-change interrupts latch the pads on every edge
+//! SENSE_MODE_OVERSAMPLE - TCC0 samples between frames, majority vote per frame
+//! SENSE_MODE_DMA       - as OVERSAMPLE, but the DMA does the port reads
+#ifndef CONF_SENSE_MODE
+#  define CONF_SENSE_MODE           SENSE_MODE_DMA
+#endif
+
+//! Adaptive scan rate: mode used once no pad was active for CONF_SENSE_IDLE_MS frames
+//! SENSE_MODE_PINCHANGE wakes on the first edge, SENSE_MODE_POLL scans every CONF_SENSE_IDLE_PERIOD frames
+#ifndef CONF_SENSE_IDLE_MODE
+#  define CONF_SENSE_IDLE_MODE      SENSE_MODE_PINCHANGE
+#endif
+#ifndef CONF_SENSE_IDLE_MS
+#  define CONF_SENSE_IDLE_MS        500
+#endif
+#ifndef CONF_SENSE_IDLE_PERIOD
+#  define CONF_SENSE_IDLE_PERIOD    16
+#endif
+
+//! TCC0 sampling rate in SENSE_MODE_OVERSAMPLE/DMA (Hz), 8 samples are voted
+#ifndef CONF_SENSE_OVERSAMPLE_HZ
+#  define CONF_SENSE_OVERSAMPLE_HZ  8000
+#endif
+
+//! Number of consecutive agreeing samples before a pad changes state (1-8, 1 = no debounce)
+#ifndef CONF_DEBOUNCE_DEPTH
+#  define CONF_DEBOUNCE_DEPTH       3
+#endif
+
+//! EEPROM address of the slider calibration record (see calib.h, ~100 bytes)
+#ifndef CONF_CALIB_EEPROM_ADDR
+#  define CONF_CALIB_EEPROM_ADDR    0x0000
+#endif
+
+//! EEPROM address of the USB polling interval (see poll.h, 3 bytes), clear of the calibration
+#ifndef CONF_POLL_EEPROM_ADDR
+#  define CONF_POLL_EEPROM_ADDR     0x0080
+#endif
+
+//! Contact decoding: runs of more than CONF_DECODE_PALM_PADS pads are ignored as a palm,
+//! pads held longer than CONF_DECODE_STUCK_MS are masked as stuck until released (0 = off)
+#ifndef CONF_DECODE_PALM_PADS
+#  define CONF_DECODE_PALM_PADS     4
+#endif
+#ifndef CONF_DECODE_STUCK_MS
+#  define CONF_DECODE_STUCK_MS      10000
+#endif
+
+//! Slider speed (half-pads/s) above which the LEDs flag a flick
+#ifndef CONF_FLING_SPEED
+#  define CONF_FLING_SPEED          200
+#endif
+
+//! Frame tick this long (us, < 1000) after the SOF so the report is built right before the
+//! host's IN token, 0 = at the SOF (run time: sof_offset). At bInterval > 1 reports are queued
+//! CONF_POLL_LEAD_FRAMES frames before the poll: 1 if the IN token comes early in the frame,
+//! 0 if it comes after the offset (run time: poll_lead).
+//! Define CONF_SOF_MEASURE to record the sample to transfer latency (sof_latency, ...)
+#ifndef CONF_SOF_OFFSET_US
+#  define CONF_SOF_OFFSET_US        700
+#endif
+#ifndef CONF_POLL_LEAD_FRAMES
+#  define CONF_POLL_LEAD_FRAMES     1
+#endif
+//#define CONF_SOF_MEASURE
+
+//! Extrapolate the reported position this far (us) ahead to hide the wait for the
+//! host IN poll (about one frame, reports are queued the frame before the poll), 0 disables
+#ifndef CONF_PREDICT_LEAD_US
+#  define CONF_PREDICT_LEAD_US      1000
+#endif
+
+//! Response curve per axis at boot (see curve.h), CURVE_LINEAR / CURVE_EXPO / CURVE_S / CURVE_CUSTOM
+//! The active curve can be changed at run time via jstk_curve[]
+#ifndef CONF_CURVE_X
+#  define CONF_CURVE_X              CURVE_LINEAR
+#endif
+#ifndef CONF_CURVE_Y
+#  define CONF_CURVE_Y              CURVE_LINEAR
+#endif
+
+//! Center handling per axis: positions within CONF_SNAP_x half-pads of the middle report exact
+//! center and light the center LEDs, axis values within CONF_DEADZONE_x counts of center are
+//! pulled to center with the rest of the range stretched (max 16383, 0 = off).
+//! Run time: jstk_snap[] / jstk_setDeadzone()
+#ifndef CONF_SNAP_X
+#  define CONF_SNAP_X               1
+#endif
+#ifndef CONF_SNAP_Y
+#  define CONF_SNAP_Y               1
+#endif
+#ifndef CONF_DEADZONE_X
+#  define CONF_DEADZONE_X           512
+#endif
+#ifndef CONF_DEADZONE_Y
+#  define CONF_DEADZONE_Y           512
+#endif
+
+//! Position hysteresis: moves smaller than CONF_HOLD_STEP half-pads are only reported
+//! after staying put for CONF_HOLD_MS, 0 disables (runtime: filter_holdTicks / filter_holdStep)
+#ifndef CONF_HOLD_MS
+#  define CONF_HOLD_MS              40
+#endif
+#ifndef CONF_HOLD_STEP
+#  define CONF_HOLD_STEP            2
+#endif
+
+//! What the axis does after the finger lifts (see filter.h): FILTER_RELEASE_CENTER / _HOLD /
+//! _DECAY / _SPRING, CONF_RELEASE_MS is the hold time or time constant (3-64 for DECAY / SPRING,
+//! run time: filter_releaseSet()).
+//! Contact losses shorter than CONF_RELEASE_DROPOUT_MS are ignored (0 = off).
+#ifndef CONF_RELEASE_MODEL
+#  define CONF_RELEASE_MODEL        FILTER_RELEASE_SPRING
+#endif
+#ifndef CONF_RELEASE_MS
+#  define CONF_RELEASE_MS           12
+#endif
+#ifndef CONF_RELEASE_DROPOUT_MS
+#  define CONF_RELEASE_DROPOUT_MS   2
+#endif
+
+//! Axis smoothing (see filter.h), FILTER_NONE / FILTER_EMA / FILTER_ONE_EURO
+//! Weights are in 1/256 per sample, all of them can be changed at run time via filter_cfg
+#ifndef CONF_FILTER_TYPE
+#  define CONF_FILTER_TYPE          FILTER_ONE_EURO
+#endif
+#ifndef CONF_FILTER_ALPHA
+#  define CONF_FILTER_ALPHA         96
+#endif
+#ifndef CONF_FILTER_MIN_ALPHA
+#  define CONF_FILTER_MIN_ALPHA     32
+#endif
+#ifndef CONF_FILTER_BETA
+#  define CONF_FILTER_BETA          16
+#endif
+#ifndef CONF_FILTER_D_ALPHA
+#  define CONF_FILTER_D_ALPHA       64
+#endif
+
+//! Define to time filter_apply() with TCD0 at clk_per (filter_benchCycles / filter_benchMax)
+//#define CONF_FILTER_BENCH
+
+//! Keypad scan: column steps per second on TCE0 (a full scan takes 5 steps) and
+//! the number of agreeing full scans before a key changes state (1-8)
+#ifndef CONF_KEYPAD_COLUMN_HZ
+#  define CONF_KEYPAD_COLUMN_HZ     2000
+#endif
+#ifndef CONF_KEYPAD_DEBOUNCE
+#  define CONF_KEYPAD_DEBOUNCE      4
+#endif
+
+//! Test mode (PB4 low): each LED pattern stays up at least CONF_LED_HOLD_MS (max 349, run time:
+//! led_holdTicks), CONF_TEST_USB 1 keeps the USB reports running while testing
+#ifndef CONF_LED_HOLD_MS
+#  define CONF_LED_HOLD_MS          10
+#endif
+#ifndef CONF_TEST_USB
+#  define CONF_TEST_USB             1
+#endif
+
+#endif // CONF_JOYSTICK_H
@@ -0,0 +1,55 @@
+/*
+ * Front panel pin map
+ *
+ * Single place that says which pins the slider pads and the keypad are wired to.
+ * pinmap.h generates the port setup and the read/gather code from these tables,
+ * so a board respin only touches this file.
+ */
+#ifndef CONF_PINMAP_H
+#define CONF_PINMAP_H
+
+//! Slider pad groups: consecutive pins of one port that map to consecutive pad bits
+//! of the packed pad word (see sense.h). Ports are given by letter.
+//! Every group is read once per sample and owns its port's INT0 and a DMA channel,
+//! so one group per port and at most 4 groups.
+#define PINMAP_SLIDER_GROUPS    4
+
+#define PINMAP_SLIDER0_PORT     C       // vertical pads 1-6
+#define PINMAP_SLIDER0_PIN      2       // lowest pin of the group
+#define PINMAP_SLIDER0_LEN      6       // number of pins
+#define PINMAP_SLIDER0_BIT      0       // pad bit of the lowest pin
+
+#define PINMAP_SLIDER1_PORT     D       // vertical pads 7-12
+#define PINMAP_SLIDER1_PIN      0
+#define PINMAP_SLIDER1_LEN      6
+#define PINMAP_SLIDER1_BIT      6
+
+#define PINMAP_SLIDER2_PORT     E       // horizontal pads 1-8
+#define PINMAP_SLIDER2_PIN      0
+#define PINMAP_SLIDER2_LEN      8
+#define PINMAP_SLIDER2_BIT      12
+
+#define PINMAP_SLIDER3_PORT     B       // horizontal pads 9-12
+#define PINMAP_SLIDER3_PIN      0
+#define PINMAP_SLIDER3_LEN      4
+#define PINMAP_SLIDER3_BIT      20
+
+//! Keypad columns (driven low one at a time) and rows (read back, pulled up)
+#define PINMAP_KEYCOLS          5
+
+#define PINMAP_KEYCOL0_PORT     F
+#define PINMAP_KEYCOL0_PIN      0
+#define PINMAP_KEYCOL1_PORT     F
+#define PINMAP_KEYCOL1_PIN      1
+#define PINMAP_KEYCOL2_PORT     F
+#define PINMAP_KEYCOL2_PIN      2
+#define PINMAP_KEYCOL3_PORT     F
+#define PINMAP_KEYCOL3_PIN      3
+#define PINMAP_KEYCOL4_PORT     B       // F2-F4 column
+#define PINMAP_KEYCOL4_PIN      7
+
+#define PINMAP_KEYROW_PORT      F       // rows are consecutive pins of one port
+#define PINMAP_KEYROW_PIN       4
+#define PINMAP_KEYROW_LEN       4
+
+#endif // CONF_PINMAP_H
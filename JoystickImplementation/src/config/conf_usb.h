@@ -110,16 +110,19 @@
 //! Interface callback definition, modified by UniWest
 #define  UDI_HID_GENERIC_ENABLE_EXT()        main_generic_enable()
 #define  UDI_HID_GENERIC_DISABLE_EXT()       main_generic_disable()
+#define  UDI_HID_GENERIC_REPORT_IN_SENT()    main_report_in_sent()
 // #define  UDI_HID_GENERIC_REPORT_OUT(ptr)     ui_led_change(ptr)
-// #define  UDI_HID_GENERIC_SET_FEATURE(report) main_hid_set_feature(report)
+#define  UDI_HID_GENERIC_SET_FEATURE(report) main_hid_set_feature(report)
 
 //! Sizes of I/O reports, modified by UniWest
-#define  UDI_HID_REPORT_IN_SIZE             2	// changed from 8 -> 2
+#define  UDI_HID_REPORT_IN_SIZE             19	// changed from 8 -> 19 (X, Y, velocity, acceleration, contacts, buttons)
 #define  UDI_HID_REPORT_OUT_SIZE            0	// changed from 8 -> 0
-#define  UDI_HID_REPORT_FEATURE_SIZE        0	// changed from 4 -> 0
+#define  UDI_HID_REPORT_FEATURE_SIZE        99	// changed from 4 -> 99 (host command, see feature.h)
 
 //! Sizes of I/O endpoints
-#define  UDI_HID_GENERIC_EP_SIZE            8
+#define  UDI_HID_GENERIC_EP_SIZE            32	// changed from 8 -> 32, report must fit one packet
+//! Default polling interval (1, 2, 4 or 8 ms), a valid EEPROM setting overrides it (see poll.h)
+#define  UDI_HID_GENERIC_EP_INTERVAL        1	// changed from 4 -> 1
 
 //@}
 //@}
@@ -129,6 +132,12 @@
  * USB Device Driver Configuration
  * @{
  */
+//! Endpoints IN run with two banks (bit mask of endpoint numbers), the next transfer
+//! is staged while the previous one waits for the IN token. The OUT endpoint of the
+//! same number is used as second bank and transfers are limited to one packet.
+//! Off for HID generic IN (EP 1): a staged bank can't be replaced, so back to back
+//! reports would go out one frame stale instead of latest wins.
+//#define  UDD_EP_PINGPONG_IN                 (1 << 1)
 //@}
 
 //! The includes of classes and other headers must be done at the end of this file to avoid compile error
@@ -0,0 +1,135 @@
+// curve.c
+#include <asf.h>
+#include "curve.h"
+
+/*
+ * Entry i is the output for the input i * 256, tables were generated with
+ *   y = 32768 + f((i * 256 - 32768) / 32768) * 32767.5
+ * for the f() given above each table. The input 65536 (past the last entry) maps to 65535.
+ */
+
+// expo: y = 0.4 x + 0.6 x^3, x and y in -1..1 around center
+PROGMEM_DECLARE(uint16_t, curve_expo[CURVE_ENTRIES]) = {
+        0,   560,  1113,  1658,  2196,  2728,  3252,  3770,
+     4280,  4784,  5282,  5772,  6257,  6734,  7205,  7670,
+     8128,  8580,  9026,  9466,  9899, 10327, 10748, 11164,
+    11573, 11977, 12375, 12767, 13153, 13534, 13909, 14279,
+    14643, 15002, 15356, 15704, 16047, 16385, 16718, 17046,
+    17368, 17686, 17999, 18307, 18610, 18909, 19202, 19492,
+    19776, 20056, 20332, 20603, 20870, 21133, 21392, 21646,
+    21896, 22142, 22385, 22623, 22857, 23088, 23314, 23538,
+    23757, 23973, 24185, 24394, 24599, 24801, 25000, 25195,
+    25387, 25576, 25762, 25945, 26125, 26302, 26476, 26648,
+    26816, 26982, 27145, 27306, 27464, 27620, 27773, 27924,
+    28072, 28218, 28362, 28504, 28644, 28782, 28918, 29052,
+    29184, 29314, 29443, 29570, 29695, 29819, 29941, 30062,
+    30181, 30299, 30415, 30531, 30645, 30758, 30870, 30981,
+    31091, 31200, 31309, 31416, 31523, 31629, 31735, 31840,
+    31944, 32048, 32152, 32255, 32358, 32461, 32563, 32666,
+    32768, 32870, 32973, 33075, 33178, 33281, 33384, 33488,
+    33592, 33696, 33801, 33907, 34013, 34120, 34227, 34336,
+    34445, 34555, 34666, 34778, 34891, 35005, 35121, 35237,
+    35355, 35474, 35595, 35717, 35841, 35966, 36093, 36222,
+    36352, 36484, 36618, 36754, 36892, 37032, 37174, 37318,
+    37464, 37612, 37763, 37916, 38072, 38230, 38391, 38554,
+    38720, 38888, 39060, 39234, 39411, 39591, 39774, 39960,
+    40149, 40341, 40536, 40735, 40937, 41142, 41351, 41563,
+    41779, 41998, 42222, 42448, 42679, 42913, 43151, 43394,
+    43640, 43890, 44144, 44403, 44666, 44933, 45204, 45480,
+    45760, 46044, 46334, 46627, 46926, 47229, 47537, 47850,
+    48168, 48490, 48818, 49151, 49489, 49832, 50180, 50534,
+    50893, 51257, 51627, 52002, 52383, 52769, 53161, 53559,
+    53963, 54372, 54788, 55209, 55637, 56070, 56510, 56956,
+    57408, 57866, 58331, 58802, 59279, 59764, 60254, 60752,
+    61256, 61766, 62284, 62808, 63340, 63878, 64423, 64976,
+};
+
+// S-curve: y = 3 |x|^2 - 2 |x|^3 per half, soft at center and at the ends
+PROGMEM_DECLARE(uint16_t, curve_s[CURVE_ENTRIES]) = {
+        0,     6,    24,    54,    94,   147,   210,   284,
+      368,   464,   569,   685,   810,   946,  1091,  1245,
+     1408,  1581,  1762,  1952,  2150,  2357,  2572,  2794,
+     3024,  3262,  3507,  3759,  4018,  4284,  4557,  4835,
+     5120,  5411,  5708,  6011,  6318,  6631,  6950,  7273,
+     7600,  7933,  8269,  8610,  8954,  9303,  9655, 10010,
+    10368, 10730, 11094, 11461, 11830, 12202, 12576, 12951,
+    13328, 13707, 14087, 14468, 14850, 15233, 15617, 16000,
+    16384, 16768, 17152, 17535, 17918, 18300, 18681, 19061,
+    19440, 19817, 20193, 20567, 20938, 21308, 21674, 22039,
+    22400, 22759, 23114, 23466, 23814, 24159, 24499, 24836,
+    25168, 25496, 25819, 26137, 26450, 26758, 27060, 27357,
+    27648, 27933, 28212, 28484, 28750, 29009, 29261, 29506,
+    29744, 29974, 30197, 30411, 30618, 30816, 31006, 31188,
+    31360, 31523, 31678, 31823, 31958, 32084, 32199, 32305,
+    32400, 32485, 32559, 32622, 32674, 32715, 32744, 32762,
+    32768, 32774, 32792, 32821, 32862, 32914, 32977, 33051,
+    33136, 33231, 33337, 33452, 33578, 33713, 33858, 34013,
+    34176, 34348, 34530, 34720, 34918, 35125, 35339, 35562,
+    35792, 36030, 36275, 36527, 36786, 37052, 37324, 37603,
+    37888, 38179, 38476, 38778, 39086, 39399, 39717, 40040,
+    40368, 40700, 41037, 41377, 41722, 42070, 42422, 42777,
+    43136, 43497, 43862, 44228, 44598, 44969, 45343, 45719,
+    46096, 46475, 46855, 47236, 47618, 48001, 48384, 48768,
+    49152, 49536, 49919, 50303, 50686, 51068, 51449, 51829,
+    52208, 52585, 52960, 53334, 53706, 54075, 54442, 54806,
+    55168, 55526, 55881, 56233, 56582, 56926, 57267, 57603,
+    57936, 58263, 58586, 58905, 59218, 59525, 59828, 60125,
+    60416, 60701, 60979, 61252, 61518, 61777, 62029, 62274,
+    62512, 62742, 62964, 63179, 63386, 63584, 63774, 63955,
+    64128, 64291, 64445, 64590, 64726, 64851, 64967, 65072,
+    65168, 65252, 65326, 65389, 65442, 65482, 65512, 65530,
+};
+
+// custom: y = x |x| as shipped, regenerate for the application
+PROGMEM_DECLARE(uint16_t, curve_custom[CURVE_ENTRIES]) = {
+        0,   510,  1016,  1518,  2016,  2510,  3000,  3486,
+     3968,  4446,  4920,  5390,  5856,  6318,  6776,  7230,
+     7680,  8126,  8568,  9006,  9440,  9870, 10296, 10718,
+    11136, 11550, 11960, 12366, 12768, 13166, 13560, 13950,
+    14336, 14718, 15096, 15470, 15840, 16206, 16568, 16926,
+    17280, 17630, 17976, 18318, 18656, 18990, 19320, 19646,
+    19968, 20286, 20600, 20910, 21216, 21518, 21816, 22110,
+    22400, 22686, 22968, 23246, 23520, 23790, 24056, 24318,
+    24576, 24830, 25080, 25326, 25568, 25806, 26040, 26270,
+    26496, 26718, 26936, 27150, 27360, 27566, 27768, 27966,
+    28160, 28350, 28536, 28718, 28896, 29070, 29240, 29406,
+    29568, 29726, 29880, 30030, 30176, 30318, 30456, 30590,
+    30720, 30846, 30968, 31086, 31200, 31310, 31416, 31518,
+    31616, 31710, 31800, 31886, 31968, 32046, 32120, 32190,
+    32256, 32318, 32376, 32430, 32480, 32526, 32568, 32606,
+    32640, 32670, 32696, 32718, 32736, 32750, 32760, 32766,
+    32768, 32770, 32776, 32786, 32800, 32818, 32840, 32866,
+    32896, 32930, 32968, 33010, 33056, 33106, 33160, 33218,
+    33280, 33346, 33416, 33490, 33568, 33650, 33736, 33826,
+    33920, 34018, 34120, 34226, 34336, 34450, 34568, 34690,
+    34816, 34946, 35080, 35218, 35360, 35506, 35656, 35810,
+    35968, 36130, 36296, 36466, 36640, 36818, 37000, 37186,
+    37376, 37570, 37768, 37970, 38176, 38386, 38600, 38818,
+    39040, 39266, 39496, 39730, 39968, 40210, 40456, 40706,
+    40960, 41218, 41480, 41746, 42016, 42290, 42568, 42850,
+    43136, 43426, 43720, 44018, 44320, 44626, 44936, 45250,
+    45568, 45890, 46216, 46546, 46880, 47218, 47560, 47906,
+    48256, 48610, 48968, 49330, 49696, 50066, 50440, 50818,
+    51200, 51586, 51976, 52370, 52768, 53170, 53576, 53986,
+    54400, 54818, 55240, 55666, 56096, 56530, 56968, 57410,
+    57856, 58306, 58760, 59218, 59680, 60146, 60616, 61090,
+    61568, 62050, 62536, 63026, 63520, 64018, 64520, 65026,
+};
+
+static const uint16_t *const curve_table[CURVE_COUNT] = {
+    [CURVE_EXPO]   = curve_expo,
+    [CURVE_S]      = curve_s,
+    [CURVE_CUSTOM] = curve_custom,
+};
+
+uint16_t curve_apply(uint8_t curve, uint16_t axis) {
+    if (curve == CURVE_LINEAR || curve >= CURVE_COUNT)
+        return axis;
+    const uint16_t *t = curve_table[curve];
+    uint8_t i = axis >> 8;
+    uint16_t w = (uint8_t)axis;
+    w += w >> 7;                    // 0..256, so 65535 lands exactly on the end point
+    uint16_t a = PROGMEM_READ_WORD(&t[i]);
+    uint16_t b = (i == CURVE_ENTRIES - 1) ? 0xFFFF : PROGMEM_READ_WORD(&t[i + 1]);
+    return a + (uint16_t)(((uint32_t)(b - a) * w) >> 8);      // tables are monotonic, b >= a
+}
@@ -0,0 +1,26 @@
+#ifndef CURVE_H
+#define CURVE_H
+
+#include <stdint.h>
+
+/*
+ * Axis response curves.
+ * Each curve is a 256 entry table in flash, indexed by the high byte of the axis value
+ * and linearly interpolated with the low byte, so every curve costs the same two flash
+ * reads and one 8x16 multiply. All curves are symmetric around JSTK_AXIS_CENTER and
+ * monotonic, and keep both ends (0 and 65535) where they are.
+ */
+
+#define CURVE_ENTRIES       256
+
+enum curve_type {
+    CURVE_LINEAR,           // pass through
+    CURVE_EXPO,             // finer control around center
+    CURVE_S,                // soft at center and near the ends
+    CURVE_CUSTOM,           // application specific, see curve.c
+    CURVE_COUNT,
+};
+
+uint16_t curve_apply(uint8_t curve, uint16_t axis);
+
+#endif // CURVE_H
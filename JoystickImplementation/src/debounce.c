@@ -0,0 +1,38 @@
+// debounce.c
+#include "debounce.h"
+
+void debounce_init(debounce_t *db, uint8_t depth, uint32_t initial) {
+    db->state = initial;
+    db->cnt0 = 0;
+    db->cnt1 = 0;
+    db->cnt2 = 0;
+    debounce_setDepth(db, depth);
+}
+
+void debounce_setDepth(debounce_t *db, uint8_t depth) {
+    if (depth < 1)
+        depth = 1;
+    if (depth > DEBOUNCE_DEPTH_MAX)
+        depth = DEBOUNCE_DEPTH_MAX;
+    depth--;                        // a bit flips when its counter already holds depth - 1
+    db->ref0 = (depth & 1) ? 0xFFFFFFFFUL : 0;
+    db->ref1 = (depth & 2) ? 0xFFFFFFFFUL : 0;
+    db->ref2 = (depth & 4) ? 0xFFFFFFFFUL : 0;
+}
+
+uint32_t debounce_update(debounce_t *db, uint32_t sample) {
+    uint32_t delta = sample ^ db->state;    // bits that disagree with the debounced state
+
+    // disagreeing bits whose counter has reached depth - 1: this sample is the last one needed
+    uint32_t flip = delta & ~((db->cnt0 ^ db->ref0) | (db->cnt1 ^ db->ref1) | (db->cnt2 ^ db->ref2));
+
+    // count up where the bit disagrees, restart where it agrees (ripple increment)
+    uint32_t c0 = db->cnt0;
+    uint32_t c1 = db->cnt1;
+    db->cnt2 = (db->cnt2 ^ (c1 & c0)) & delta & ~flip;
+    db->cnt1 = (c1 ^ c0) & delta & ~flip;
+    db->cnt0 = ~c0 & delta & ~flip;
+
+    db->state ^= flip;
+    return db->state;
+}
@@ -0,0 +1,33 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Bit-sliced vertical counter debounce.
+ * Every bit of the word has its own 3 bit counter, stored as three bit planes,
+ * so all pads are debounced with the same few bitwise ops per sample.
+ * A bit only changes state after 'depth' consecutive samples (1-8) that
+ * disagree with the current state, any agreeing sample restarts its count.
+ *
+ * No hardware access, the module builds on the host as well.
+ */
+
+#define DEBOUNCE_DEPTH_MAX  8
+
+typedef struct {
+    uint32_t state;                 // debounced word
+    uint32_t cnt0, cnt1, cnt2;      // counter bit planes (LSB..MSB)
+    uint32_t ref0, ref1, ref2;      // depth - 1 as all-ones/all-zeros planes
+} debounce_t;
+
+void debounce_init(debounce_t *db, uint8_t depth, uint32_t initial);
+void debounce_setDepth(debounce_t *db, uint8_t depth);
+uint32_t debounce_update(debounce_t *db, uint32_t sample);   // returns the debounced word
+
+static inline bool debounce_busy(const debounce_t *db) {
+    return (db->cnt0 | db->cnt1 | db->cnt2) != 0;           // some bit is still counting
+}
+
+#endif // DEBOUNCE_H
@@ -0,0 +1,96 @@
+// decode.c
+#include <stdbool.h>
+#include <string.h>
+#include "decode.h"
+#include "conf_joystick.h"
+
+uint8_t decode_palmPads = CONF_DECODE_PALM_PADS;
+uint16_t decode_stuckAge = DECODE_AGE_MS(CONF_DECODE_STUCK_MS);
+
+// index of the lowest set bit of a nibble, 4 when the nibble is empty
+static const uint8_t decode_ctz4[16] = {
+    4, 0, 1, 0,     2, 0, 1, 0,
+    3, 0, 1, 0,     2, 0, 1, 0
+};
+
+// index of the lowest set bit of a 12 bit word, 12 when empty (3 table lookups at most)
+static uint8_t decode_ctz12(uint16_t bits) {
+    uint8_t n = decode_ctz4[bits & 0x0F];
+    if (n < 4)
+        return n;
+    n = decode_ctz4[(bits >> 4) & 0x0F];
+    if (n < 4)
+        return 4 + n;
+    return 8 + decode_ctz4[(bits >> 8) & 0x0F];
+}
+
+static uint8_t decode_dist(int8_t a, int8_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+void decode_contacts(uint16_t bits, int8_t prev, decode_t *out) {
+    const uint16_t all = (1u << DECODE_PADS) - 1;
+    uint8_t w1 = 0, w2 = 0;                         // widths of the two best runs
+
+    out->pos = -1;
+    out->pos2 = -1;
+    out->count = 0;
+    bits &= all;
+
+    while (bits) {                                  // one pass per run, 6 at most
+        uint8_t first = decode_ctz12(bits);
+        // run length = trailing ones after the first pad = trailing zeros of the complement
+        uint8_t len = decode_ctz12(~(bits >> first) & all);
+        bits &= ~(((1u << len) - 1) << first);      // consume the run
+
+        if (len > decode_palmPads)
+            continue;                               // palm, ignore
+        out->count++;
+
+        int8_t pos = (int8_t)(2 * first + len - 1); // first + last pad of the run
+        bool better = (len > w1)
+            || (len == w1 && prev >= 0 && decode_dist(pos, prev) < decode_dist(out->pos, prev));
+        if (better) {
+            out->pos2 = out->pos;
+            w2 = w1;
+            out->pos = pos;
+            w1 = len;
+        } else if (len > w2) {
+            out->pos2 = pos;
+            w2 = len;
+        }
+    }
+}
+
+
+void decode_stuckInit(decode_stuck_t *s, uint16_t now) {
+    memset(s, 0, sizeof(*s));
+    s->last = now;
+}
+
+uint32_t decode_stuckUpdate(decode_stuck_t *s, uint32_t pads, uint16_t now) {
+    uint16_t dt = now - s->last;
+    s->last = now;
+    if (!s->pads)
+        dt = 0;                                     // nothing was held, the gap may be an idle sleep
+    s->frac += dt;
+    uint16_t units = s->frac >> DECODE_AGE_SHIFT;
+    s->frac &= (1u << DECODE_AGE_SHIFT) - 1;
+
+    if (pads | s->pads) {                           // skip the pad loop while untouched
+        uint32_t bit = 1;
+        for (uint8_t i = 0; i < DECODE_SLIDER_PADS; i++, bit <<= 1) {
+            if (!(pads & bit)) {
+                s->age[i] = 0;                      // released, give it another chance
+                s->stuck &= ~bit;
+                continue;
+            }
+            uint16_t age = s->age[i] + units;
+            s->age[i] = (age < s->age[i]) ? 0xFFFF : age;
+            if (decode_stuckAge && s->age[i] >= decode_stuckAge)
+                s->stuck |= bit;
+        }
+    }
+    s->pads = pads;
+    return pads & ~s->stuck;
+}
@@ -0,0 +1,56 @@
+#ifndef DECODE_H
+#define DECODE_H
+
+#include <stdint.h>
+
+/*
+ * Slider contact decoder.
+ * A finger bridging two pads activates both, so the position of a contact is taken as
+ * the center of its contiguous run of active pads, in half-pad steps:
+ *   pad i alone     -> 2*i
+ *   pads i and i+1  -> 2*i + 1
+ * which gives 23 levels (0-22) for a 12 pad slider.
+ *
+ * Every run of the 12 bit word is a contact candidate (at most 6, so the scan is bounded).
+ * Runs wider than decode_palmPads are a palm or a hand resting on the slider and are dropped.
+ * The widest remaining run is the dominant contact, ties go to the one closest to the
+ * previous dominant position so two equal fingers do not swap every frame.
+ *
+ * The stuck pad tracker works on the whole packed pad word (see sense.h) and removes pads
+ * that have been active for longer than decode_stuckAge, until they release.
+ *
+ * No hardware access, the module builds on the host as well.
+ */
+
+#define DECODE_PADS         12
+#define DECODE_POS_MAX      (2 * DECODE_PADS - 2)  // 22
+#define DECODE_SLIDER_PADS  24                      // pads in the packed word
+
+// stuck pad ages count in units of 1024 timebase ticks (5.46 ms)
+#define DECODE_AGE_SHIFT    10
+#define DECODE_AGE_MS(ms)   ((uint16_t)((((uint32_t)(ms) * 375) / 2) >> DECODE_AGE_SHIFT))
+
+typedef struct {
+    int8_t pos;                     // dominant contact, -1 if none
+    int8_t pos2;                    // second contact, -1 if none
+    uint8_t count;                  // accepted contacts (palms not counted)
+} decode_t;
+
+typedef struct {
+    uint32_t pads;                  // pads active at the previous call
+    uint32_t stuck;                 // pads masked until they release
+    uint16_t last;                  // timebase stamp of the previous call
+    uint16_t frac;                  // ticks not yet counted into the ages
+    uint16_t age[DECODE_SLIDER_PADS];
+} decode_stuck_t;
+
+extern uint8_t decode_palmPads;     // widest run still taken as a finger
+extern uint16_t decode_stuckAge;    // DECODE_AGE_MS() units, 0 = never mask
+
+// bits: 1 = pad touched, prev: dominant position of the previous frame (or -1)
+void decode_contacts(uint16_t bits, int8_t prev, decode_t *out);
+
+void decode_stuckInit(decode_stuck_t *s, uint16_t now);
+uint32_t decode_stuckUpdate(decode_stuck_t *s, uint32_t pads, uint16_t now);  // returns pads without the stuck ones
+
+#endif // DECODE_H
@@ -0,0 +1,59 @@
+// feature.c
+#include <asf.h>
+#include <string.h>
+#include "feature.h"
+#include "poll.h"
+#include "calib.h"
+
+#if UDI_HID_REPORT_FEATURE_SIZE != FEATURE_SIZE
+#  error "UDI_HID_REPORT_FEATURE_SIZE in conf_usb.h must match the feature.h command layout"
+#endif
+
+static uint8_t feature_report[FEATURE_SIZE];
+static volatile bool feature_dirty;        // copied but not run yet
+
+void feature_received(const uint8_t *report) {
+    memcpy(feature_report, report, FEATURE_SIZE);
+    feature_dirty = true;
+}
+
+static uint16_t feature_get16(const uint8_t *src) {
+    return src[0] | ((uint16_t)src[1] << 8);    // little endian, as the IN report
+}
+
+static void feature_calib(const uint8_t *src) {
+    calib_t c;
+    for (uint8_t a = 0; a < CALIB_AXES; a++) {
+        c.axis[a].invert = (src[0] != 0);
+        c.axis[a].center = (int16_t)feature_get16(&src[1]);
+        for (uint8_t p = 0; p < CALIB_POSITIONS; p++)
+            c.axis[a].value[p] = feature_get16(&src[3 + 2 * p]);
+        src += FEATURE_CALIB_AXIS;
+    }
+    calib_save(&c);                         // blocks a few ms
+}
+
+bool feature_pending(void) {
+    return feature_dirty;
+}
+
+void feature_task(void) {
+    if (!feature_dirty)
+        return;
+    uint8_t report[FEATURE_SIZE];
+    irqflags_t flags = cpu_irq_save();      // the next SET_FEATURE may overwrite it
+    memcpy(report, feature_report, FEATURE_SIZE);
+    feature_dirty = false;
+    cpu_irq_restore(flags);
+
+    switch (report[0]) {
+    case FEATURE_POLL:
+        poll_set(report[1]);                // invalid intervals are ignored
+        break;
+    case FEATURE_CALIB:
+        feature_calib(&report[1]);
+        break;
+    default:
+        break;
+    }
+}
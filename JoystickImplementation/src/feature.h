@@ -0,0 +1,34 @@
+#ifndef FEATURE_H
+#define FEATURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "calib.h"
+
+/*
+ * Host commands over the HID SET_FEATURE report (report ID 0, UDI_HID_REPORT_FEATURE_SIZE bytes).
+ * Byte 0 is the command, the rest its arguments, unused bytes are ignored:
+ *   FEATURE_POLL    [1] polling interval in ms (1, 2, 4, 8), stored in EEPROM, the host
+ *                       gets it with the next enumeration (see poll.h)
+ *   FEATURE_CALIB   per axis (CALIB_HORI, then CALIB_VERT), 16 bit values little endian:
+ *                       invert, center, value[CALIB_POSITIONS], written to EEPROM and
+ *                       applied at once (see calib.h)
+ * The USB interrupt only copies the report, feature_task() runs the command from the main
+ * loop since EEPROM writes block for a few ms. A newer report replaces one not run yet.
+ */
+
+enum feature_cmd {
+    FEATURE_NONE,
+    FEATURE_POLL,
+    FEATURE_CALIB,
+};
+
+#define FEATURE_CALIB_AXIS  (1 + 2 + 2 * CALIB_POSITIONS)     // bytes per axis
+#define FEATURE_CALIB_AXES  2                                  // CALIB_AXES, for the preprocessor
+#define FEATURE_SIZE    (1 + FEATURE_CALIB_AXES * FEATURE_CALIB_AXIS)   // command + largest argument block
+
+void feature_received(const uint8_t *report);  // USB interrupt, from UDI_HID_GENERIC_SET_FEATURE()
+bool feature_pending(void);
+void feature_task(void);                        // main loop
+
+#endif // FEATURE_H
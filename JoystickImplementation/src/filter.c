@@ -0,0 +1,210 @@
+// filter.c
+#include <asf.h>
+#include "filter.h"
+#include "timebase.h"
+#include "conf_joystick.h"
+
+filter_cfg_t filter_cfg = {
+    .type     = CONF_FILTER_TYPE,
+    .alpha    = CONF_FILTER_ALPHA,
+    .minAlpha = CONF_FILTER_MIN_ALPHA,
+    .beta     = CONF_FILTER_BETA,
+    .dAlpha   = CONF_FILTER_D_ALPHA,
+};
+
+uint16_t filter_holdTicks = TIMEBASE_MS(CONF_HOLD_MS);
+uint8_t filter_holdStep = CONF_HOLD_STEP;
+
+uint16_t filter_dropoutTicks = TIMEBASE_MS(CONF_RELEASE_DROPOUT_MS);
+
+// release model
+static uint8_t filter_relModel;
+static uint16_t filter_relK;            // weight per frame (1 / time constant), 12 fraction bits
+static uint16_t filter_relTicks;        // hold time
+#define FILTER_RELEASE_FRAC     12      // fraction bits of y, z and filter_relK
+#define FILTER_RELEASE_SETTLE   16      // counts from center that end the release
+
+uint16_t filter_benchCycles;
+uint16_t filter_benchMax;
+
+#ifdef CONF_FILTER_BENCH
+#  define FILTER_BENCH_TC   TCD0    // free running at clk_per while benchmarking
+
+static void filter_benchStart(void) {
+    if (FILTER_BENCH_TC.CTRLA == TC_CLKSEL_OFF_gc) {
+        sysclk_enable_peripheral_clock(&FILTER_BENCH_TC);
+        FILTER_BENCH_TC.PER = 0xFFFF;
+        FILTER_BENCH_TC.CTRLA = TC_CLKSEL_DIV1_gc;
+    }
+}
+#endif
+
+
+void filter_holdReset(filter_hold_t *h, int8_t pos) {
+    h->pos = pos;
+    h->cand = pos;
+}
+
+int8_t filter_hold(filter_hold_t *h, int8_t pos, uint16_t now) {
+    if (pos < 0 && h->pos >= 0 && filter_dropoutTicks) {    // contact lost, wait out short dropouts
+        if (h->cand != pos) {
+            h->cand = pos;
+            h->since = now;
+            return h->pos;
+        }
+        if ((uint16_t)(now - h->since) < filter_dropoutTicks)
+            return h->pos;
+    }
+    if (pos == h->pos) {                // back where we were, drop the candidate
+        h->cand = pos;
+        return pos;
+    }
+    uint8_t dist = (pos > h->pos) ? pos - h->pos : h->pos - pos;
+    if (pos < 0 || h->pos < 0 || dist >= filter_holdStep || filter_holdTicks == 0) {
+        filter_holdReset(h, pos);       // touch, release or a real move: no delay
+        return pos;
+    }
+    if (pos != h->cand) {               // new small move, start timing it
+        h->cand = pos;
+        h->since = now;
+    } else if ((uint16_t)(now - h->since) >= filter_holdTicks) {
+        h->pos = pos;                   // stayed there long enough
+    }
+    return h->pos;
+}
+
+
+void filter_deadzoneSet(filter_deadzone_t *dz, uint16_t width) {
+    if (width > FILTER_DEADZONE_MAX)
+        width = FILTER_DEADZONE_MAX;
+    dz->width = width;
+    uint16_t rest = 0x7FFF - width;
+    dz->gain = (((uint32_t)0x7FFF << 16) + rest - 1) / rest;    // rounded up so the ends still reach 0 / 65535
+}
+
+uint16_t filter_deadzone(const filter_deadzone_t *dz, uint16_t axis) {
+    if (!dz->width)
+        return axis;
+    bool below = (axis < 0x8000);
+    uint16_t d = below ? 0x8000 - axis : axis - 0x8000;
+    if (d <= dz->width)
+        return 0x8000;                  // parked around center
+    uint32_t out = ((uint32_t)(d - dz->width) * dz->gain) >> 16;
+    if (below)
+        return (out >= 0x8000) ? 0 : 0x8000 - (uint16_t)out;
+    return (out >= 0x7FFF) ? 0xFFFF : 0x8000 + (uint16_t)out;
+}
+
+
+void filter_releaseSet(uint8_t model, uint16_t ms) {
+    filter_relModel = model;
+    filter_relTicks = TIMEBASE_MS(ms < 349 ? ms : 349);
+    if (ms < FILTER_RELEASE_MS_MIN)
+        ms = FILTER_RELEASE_MS_MIN;
+    if (ms > FILTER_RELEASE_MS_MAX)
+        ms = FILTER_RELEASE_MS_MAX;
+    filter_relK = (uint16_t)(((1UL << FILTER_RELEASE_FRAC) + ms / 2) / ms);    // 1 frame = 1 ms
+}
+
+// d * filter_relK, rounded; split so |d| up to 2^27 stays within 32 bit
+static int32_t filter_relStep(int32_t d) {
+    int32_t hi = d >> FILTER_RELEASE_FRAC;
+    int32_t lo = d & ((1L << FILTER_RELEASE_FRAC) - 1);
+    return hi * filter_relK + ((lo * filter_relK + (1L << (FILTER_RELEASE_FRAC - 1))) >> FILTER_RELEASE_FRAC);
+}
+
+void filter_releaseTrack(filter_release_t *r, uint16_t axis, uint16_t now) {
+    r->y = ((int32_t)axis - 0x8000) << FILTER_RELEASE_FRAC;
+    r->z = r->y;
+    r->since = now;
+    r->armed = (filter_relModel != FILTER_RELEASE_CENTER);
+    r->active = false;
+}
+
+uint16_t filter_release(filter_release_t *r, uint16_t now) {
+    if (r->armed) {                     // first frame without contact
+        r->armed = false;
+        r->active = true;
+    }
+    if (!r->active)
+        return 0x8000;
+
+    switch (filter_relModel) {
+    case FILTER_RELEASE_HOLD:
+        if ((uint16_t)(now - r->since) >= filter_relTicks)
+            r->y = 0;
+        break;
+    case FILTER_RELEASE_DECAY:
+        r->y -= filter_relStep(r->y);
+        break;
+    case FILTER_RELEASE_SPRING:         // two equal lags in series: y0 (1 + t/T) e^(-t/T)
+        r->z -= filter_relStep(r->z);
+        r->y += filter_relStep(r->z - r->y);
+        break;
+    default:
+        r->y = 0;
+        break;
+    }
+
+    int32_t off = r->y >> FILTER_RELEASE_FRAC;
+    int32_t lag = r->z >> FILTER_RELEASE_FRAC;  // |z| <= |y|, checked for HOLD/DECAY where z stays put
+    if (off >= -FILTER_RELEASE_SETTLE && off <= FILTER_RELEASE_SETTLE
+     && (filter_relModel != FILTER_RELEASE_SPRING || (lag >= -FILTER_RELEASE_SETTLE && lag <= FILTER_RELEASE_SETTLE))) {
+        r->active = false;              // close enough, finish on exact center
+        r->y = 0;
+        off = 0;
+    }
+    int32_t axis = 0x8000 + off;
+    return (axis < 0) ? 0 : (axis > 0xFFFF) ? 0xFFFF : (uint16_t)axis;
+}
+
+
+void filter_reset(filter_t *f) {
+    f->primed = false;
+}
+
+// one EMA step: acc moves 'alpha'/256 of the way to x (diff * alpha is already in 1/256 units)
+static void filter_ema(int32_t *acc, int32_t x, uint8_t alpha) {
+    int32_t diff = x - (*acc >> 8);
+    *acc += diff * alpha;
+}
+
+static uint16_t filter_run(filter_t *f, uint16_t x) {
+    if (!f->primed) {                   // touch down: start at the finger, not at center
+        f->y = (int32_t)x << 8;
+        f->dx = 0;
+        f->x = x;
+        f->primed = true;
+        return x;
+    }
+
+    uint8_t alpha = filter_cfg.alpha;
+    if (filter_cfg.type == FILTER_ONE_EURO) {
+        filter_ema(&f->dx, (int32_t)x - f->x, filter_cfg.dAlpha);
+        uint16_t speed = (uint16_t)(((f->dx < 0) ? -f->dx : f->dx) >> 12);    // counts/sample / 16
+        uint16_t open = filter_cfg.minAlpha + (uint16_t)filter_cfg.beta * (speed > 255 ? 255 : speed);
+        alpha = (open > 255) ? 255 : (uint8_t)open;
+    }
+    f->x = x;
+
+    if (filter_cfg.type == FILTER_NONE) {
+        f->y = (int32_t)x << 8;
+        return x;
+    }
+    filter_ema(&f->y, x, alpha);
+    return (uint16_t)(f->y >> 8);
+}
+
+uint16_t filter_apply(filter_t *f, uint16_t x) {
+#ifdef CONF_FILTER_BENCH
+    filter_benchStart();
+    uint16_t start = FILTER_BENCH_TC.CNT;
+    uint16_t y = filter_run(f, x);
+    filter_benchCycles = FILTER_BENCH_TC.CNT - start;
+    if (filter_benchCycles > filter_benchMax)
+        filter_benchMax = filter_benchCycles;
+    return y;
+#else
+    return filter_run(f, x);
+#endif
+}
@@ -0,0 +1,126 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Axis smoothing filters, integer only (16 bit state, 8 bit coefficients).
+ * Weights are in 1/256: 255 follows the input almost immediately, small values smooth hard.
+ *
+ * FILTER_EMA        y += alpha * (x - y)
+ * FILTER_ONE_EURO   speed adaptive EMA (1-euro filter): the weight opens from minAlpha
+ *                   by beta per 16 counts/sample of smoothed speed, so the axis is calm
+ *                   while the finger rests and lag-free while it moves.
+ *                   The cutoff frequency of the original filter is expressed directly
+ *                   as a weight to stay clear of division and floats.
+ *
+ * filter_hold() sits in front of all that on the half-pad position: a move of less than
+ * filter_holdStep is only committed once it has been stable for filter_holdTicks, so a
+ * finger resting on a pad boundary does not flood the host with reports. A lost contact is
+ * only committed after filter_dropoutTicks, so 1-2 ms dropouts never reach the report.
+ *
+ * filter_deadzone() works on the 16 bit axis value: everything within 'width' of center
+ * reports exact center, the rest is stretched so the ends still reach 0 and 65535.
+ *
+ * filter_release() replaces the jump to center after the finger lifts, one step per frame:
+ * FILTER_RELEASE_CENTER   jump at once (no model)
+ * FILTER_RELEASE_HOLD     keep the last value for the release time, then center
+ * FILTER_RELEASE_DECAY    exponential decay, the release time is the time constant
+ * FILTER_RELEASE_SPRING   critically damped spring (two equal lags in series), no overshoot,
+ *                         under 4% left after 5 release times, centered after about 10
+ * DECAY and SPRING take release times of FILTER_RELEASE_MS_MIN..MAX, others are clamped.
+ *
+ * Cost of filter_apply() per sample, UNMEASURED ESTIMATES: counted by hand from the
+ * operations the avr-gcc -Os code needs, with XMEGA instruction timings. Nothing was
+ * compiled or run; build with CONF_FILTER_BENCH and read filter_benchMax for real numbers.
+ * FILTER_EMA        est. ~110 cycles   one 32 bit multiply (__mulsi3, ~30 with the call)
+ * FILTER_ONE_EURO   est. ~230 cycles   two EMA steps, |dx| >> 12, 8x16 bit weight multiply
+ * If these hold, both axes take under 500 cycles, about 4% of a 1 ms frame at 12 MHz.
+ */
+
+enum filter_type {
+    FILTER_NONE,
+    FILTER_EMA,
+    FILTER_ONE_EURO,
+};
+
+typedef struct {
+    uint8_t type;                   // enum filter_type
+    uint8_t alpha;                  // EMA weight
+    uint8_t minAlpha;               // 1-euro weight at rest
+    uint8_t beta;                   // 1-euro weight increase with speed
+    uint8_t dAlpha;                 // 1-euro weight of the speed estimate
+} filter_cfg_t;
+
+typedef struct {
+    int32_t y;                      // output, 8 fraction bits
+    int32_t dx;                     // smoothed speed in counts/sample, 8 fraction bits
+    uint16_t x;                     // previous input
+    bool primed;
+} filter_t;
+
+typedef struct {
+    int8_t pos;                     // committed position, -1 = no contact
+    int8_t cand;                    // position waiting to become stable
+    uint16_t since;                 // timebase stamp cand was first seen
+} filter_hold_t;
+
+enum filter_release {
+    FILTER_RELEASE_CENTER,
+    FILTER_RELEASE_HOLD,
+    FILTER_RELEASE_DECAY,
+    FILTER_RELEASE_SPRING,
+};
+
+#define FILTER_RELEASE_MS_MIN   3       // release times checked for DECAY and SPRING (ms)
+#define FILTER_RELEASE_MS_MAX   64
+
+typedef struct {
+    int32_t y;                      // offset from center, 12 fraction bits
+    int32_t z;                      // spring: output of the first lag, 12 fraction bits
+    uint16_t since;                 // timebase stamp of the last tracked value
+    bool armed;                     // touched, the next release runs the model
+    bool active;                    // returning to center
+} filter_release_t;
+
+typedef struct {
+    uint16_t width;                 // axis counts each side of center, 0 = off
+    uint32_t gain;                  // stretch of the remaining range, 16 fraction bits
+} filter_deadzone_t;
+
+#define FILTER_DEADZONE_MAX 16383   // keeps the stretch within 32 bit math
+
+extern filter_cfg_t filter_cfg;     // runtime tunable, shared by both axes
+extern uint16_t filter_holdTicks;  // stable time before a small move is committed, 0 = off
+extern uint8_t filter_holdStep;     // half-pads, moves this large are committed at once
+extern uint16_t filter_dropoutTicks; // contact loss shorter than this is ignored, 0 = off
+extern uint16_t filter_benchCycles; // CONF_FILTER_BENCH: cycles of the last filter_apply()
+extern uint16_t filter_benchMax;    // CONF_FILTER_BENCH: worst case seen
+
+void filter_reset(filter_t *f);
+uint16_t filter_apply(filter_t *f, uint16_t x);
+
+static inline bool filter_busy(const filter_t *f) {
+    return f->primed && (uint16_t)(f->y >> 8) != f->x;   // output still settling
+}
+
+void filter_holdReset(filter_hold_t *h, int8_t pos);
+int8_t filter_hold(filter_hold_t *h, int8_t pos, uint16_t now);
+
+void filter_deadzoneSet(filter_deadzone_t *dz, uint16_t width);
+uint16_t filter_deadzone(const filter_deadzone_t *dz, uint16_t axis);
+
+static inline bool filter_holdBusy(const filter_hold_t *h) {
+    return h->cand != h->pos;       // a candidate is still being timed
+}
+
+void filter_releaseSet(uint8_t model, uint16_t ms);     // shared by both axes
+void filter_releaseTrack(filter_release_t *r, uint16_t axis, uint16_t now);    // while touched
+uint16_t filter_release(filter_release_t *r, uint16_t now); // per frame after the finger lifted
+
+static inline bool filter_releaseBusy(const filter_release_t *r) {
+    return r->active;
+}
+
+#endif // FILTER_H
@@ -1,103 +1,197 @@
 #include <asf.h>
-#include <util/delay.h>
+#include <string.h>
 
 #include "led.h"
 #include "joystick.h"
+#include "sense.h"
+#include "decode.h"
+#include "debounce.h"
+#include "motion.h"
+#include "filter.h"
+#include "calib.h"
+#include "curve.h"
+#include "keypad.h"
+#include "poll.h"
+#include "sof.h"
+#include "timebase.h"
+#include "conf_joystick.h"
 #include "udi_hid_generic.h"
 
-#define SLIDER_COUNT   12
-
 uint8_t jstk_mask;  // bitmask of LED's to turn on
 volatile uint8_t jstk_testMode;
 
 
-static int8_t jstk_scan(uint16_t jstk_bits) {
-    for (int8_t i = 0; i < SLIDER_COUNT; i++)   // iterates through slider
-        if ((jstk_bits & (1u << i)) == 0)       // active when low
-            return i;                           // returns active pad index
-    return -1;                                  // nothing being touched
+static uint32_t jstk_pads;      // debounced pad word of this frame, 1 = touched (see sense.h)
+static bool jstk_reportPending; // changed report held back until the poll phase (see poll_due())
+static debounce_t jstk_debounce;
+static decode_stuck_t jstk_stuck;
+static decode_t jstk_contactX = { -1, -1, 0 };  // contacts on the horizontal slider
+static decode_t jstk_contactY = { -1, -1, 0 };
+static motion_t jstk_motionX;       // horizontal slider
+static motion_t jstk_motionY;       // vertical slider
+static filter_hold_t jstk_holdX;     // committed positions, see filter_hold()
+static filter_hold_t jstk_holdY;
+static filter_t jstk_filterX;
+static filter_t jstk_filterY;
+static filter_release_t jstk_releaseX;  // return to center after the finger lifts
+static filter_release_t jstk_releaseY;
+static uint16_t jstk_now;           // timebase stamp of the frame being processed
+uint16_t jstk_predictLead = TIMEBASE_US(CONF_PREDICT_LEAD_US);  // extrapolation in ticks, 0 = off
+uint8_t jstk_curve[CALIB_AXES] = { CONF_CURVE_X, CONF_CURVE_Y };
+uint8_t jstk_snap[CALIB_AXES] = { CONF_SNAP_X, CONF_SNAP_Y };
+static filter_deadzone_t jstk_deadzone[CALIB_AXES];
+
+static int8_t jstk_decodeVert(void);
+static int8_t jstk_decodeHori(void);
+
+
+void jstk_init(void)
+{
+    calib_init();                   // orientation and axis tables for this panel
+    jstk_setDeadzone(CALIB_HORI, CONF_DEADZONE_X);
+    jstk_setDeadzone(CALIB_VERT, CONF_DEADZONE_Y);
+    filter_releaseSet(CONF_RELEASE_MODEL, CONF_RELEASE_MS);
+    uint32_t jstk_raw;
+    sense_update(&jstk_raw);
+    debounce_init(&jstk_debounce, CONF_DEBOUNCE_DEPTH, jstk_raw);   // start settled, no edge at boot
+    decode_stuckInit(&jstk_stuck, timebase_now());
+    jstk_pads = jstk_raw;
+    motion_init(&jstk_motionX);
+    motion_init(&jstk_motionY);
+    filter_reset(&jstk_filterX);
+    filter_reset(&jstk_filterY);
+    filter_holdReset(&jstk_holdX, jstk_decodeHori());
+    filter_holdReset(&jstk_holdY, jstk_decodeVert());
 }
 
+
 /*
  * The sliders are really just 12 buttons which are pressed as you move your finger up/down or left/right.
  * Similar to sweeping your fingers across the keys of a piano.
+ * A finger between two keys presses both, decode.c turns that into a half-pad position (0-22).
  */
 
 // vertical slider
 static uint16_t jstk_readVertRaw(void) {
-    uint8_t jstk_c = PORTC.IN;
-    uint8_t jstk_d = PORTD.IN;
-    uint16_t jstk_w = ((uint16_t)jstk_d << 8) | jstk_c; // build 16 bit word
-    jstk_w >>= 2;                                       // discard C0 & C1
-    return jstk_w & 0x0FFF;                             // keep only bits 0–11
+    return (uint16_t)(jstk_pads >> SENSE_VERT_SHIFT) & SENSE_AXIS_MASK;
 }   // only return C2-C7 and D0-D5
 
+static int8_t jstk_decodeVert(void) {
+    decode_contacts(jstk_readVertRaw(), jstk_contactY.pos, &jstk_contactY);
+    return calib_orient(CALIB_VERT, jstk_contactY.pos);   // dominant contact, oriented for this panel
+}
+
+int8_t jstk_readVertPos(void) {
+    return jstk_holdY.pos;
+}   // committed position of this frame
+
 int8_t jstk_readVertIndex(void) {
-    int8_t idx = jstk_scan(jstk_readVertRaw());
-    // if (idx >= 0)
-    //     idx = 11 - idx;
-    return idx;
+    int8_t pos = jstk_readVertPos();
+    return (pos < 0) ? -1 : (pos >> 1);     // lower pad when bridging two
 }
 
 // horizontal slider
 static uint16_t jstk_readHoriRaw(void) {
-    uint8_t jstk_e = PORTE.IN;
-    uint8_t jstk_b = PORTB.IN;
-    uint16_t jstk_w = ((uint16_t)jstk_b << 8) | jstk_e;
-    return jstk_w & 0x0FFF;	// B4–B7 = bits 12-15, so they get discarded
+    return (uint16_t)(jstk_pads >> SENSE_HORI_SHIFT) & SENSE_AXIS_MASK;
+}   // only return E0-E7 and B0-B3
+
+static int8_t jstk_decodeHori(void) {
+    decode_contacts(jstk_readHoriRaw(), jstk_contactX.pos, &jstk_contactX);
+    return calib_orient(CALIB_HORI, jstk_contactX.pos);   // dominant contact, oriented for this panel
+}
+
+int8_t jstk_readHoriPos(void) {
+    return jstk_holdX.pos;
 }
 
 int8_t jstk_readHoriIndex(void) {
-    int8_t idx = jstk_scan(jstk_readHoriRaw());
-    // if (idx >= 0)
-    //     idx = 11 - idx;
-    return idx;
+    int8_t pos = jstk_readHoriPos();
+    return (pos < 0) ? -1 : (pos >> 1);
 }
 
 
 // joystick USB stuff
-static const uint8_t jstk_idx2axis[12] = {
-    0,      23,     46,     69,
-    92,     116,    139,    162,
-    185,    208,    231,    255
-};  // lookup table for the 12 discrete slider positions to avoid long division
+uint16_t jstk_posToAxis(uint8_t axis, int8_t pos) {
+    return calib_toAxis(axis, pos);     // center when no contact
+}   // calibrated lookup table, runtime is O(1)
 
-uint8_t jstk_idxToAxis(int8_t idx) {
-    if (idx < 0)
-        return 128; // return to center when no contact
-    return jstk_idx2axis[idx];
-}   // conversion runtime is O(1)
+void jstk_setDeadzone(uint8_t axis, uint16_t width) {
+    filter_deadzoneSet(&jstk_deadzone[axis], width);
+}
+
+// finger within the center snap window of this axis
+static bool jstk_centered(uint8_t axis, int8_t pos) {
+    uint8_t off = (pos > JSTK_POS_CENTER) ? pos - JSTK_POS_CENTER : JSTK_POS_CENTER - pos;
+    return pos >= 0 && off <= jstk_snap[axis];
+}
+
+// axis change from the motion position to its neighbour in the direction of travel (calibrated)
+static int32_t jstk_axisStep(uint8_t which, const motion_t *m) {
+    if (m->pos < 0)
+        return 0;
+    int8_t dir = (m->vel > 0) ? 1 : -1;
+    int8_t next = m->pos + dir;
+    if (next < 0 || next > DECODE_POS_MAX)      // at the end, use the step behind
+        return (int32_t)jstk_posToAxis(which, m->pos) - jstk_posToAxis(which, m->pos - dir);
+    return (int32_t)jstk_posToAxis(which, next) - jstk_posToAxis(which, m->pos);
+}
+
+// axis value for the report: smoothed, pushed ahead to the expected host poll when prediction is on,
+// snapped / dead zoned around center, then shaped by the response curve
+static uint16_t jstk_axisOut(uint8_t which, const motion_t *m, filter_t *f, filter_release_t *r, int8_t pos) {
+    if (pos < 0) {
+        filter_reset(f);            // next touch starts at the finger
+        return filter_release(r, jstk_now);     // back to center as the release model says
+    }
+    uint16_t axis = filter_apply(f, jstk_posToAxis(which, pos));
+    if (jstk_predictLead)
+        axis = motion_predict(m, axis, jstk_axisStep(which, m), jstk_now, jstk_predictLead);
+    if (jstk_centered(which, pos))
+        axis = JSTK_AXIS_CENTER;    // finger parked on the middle pads
+    axis = filter_deadzone(&jstk_deadzone[which], axis);
+    axis = curve_apply(jstk_curve[which], axis);
+    filter_releaseTrack(r, axis, jstk_now);     // where a release will start from
+    return axis;
+}
 
 
 uint8_t jstk_readMask(void)
 {
-    int8_t vi = jstk_readVertIndex();       // -1 to 11
-    int8_t hi = jstk_readHoriIndex();       // -1 to 11
+    int8_t vp = jstk_readVertPos();         // -1 to 22
+    int8_t hp = jstk_readHoriPos();         // -1 to 22
 
-    if (vi < 0 && hi < 0)
+    if (vp < 0 && hp < 0)
         return 0;                           // no contact
 
     // decide which slider is moved furthest from center buy computing 'distance' from middle
-    uint8_t dV = (vi < 0) ? 0 : (vi > 5 ? vi - 5 : 5 - vi); // vertical slider 'distance'   (dV)
-    uint8_t dH = (hi < 0) ? 0 : (hi > 5 ? hi - 5 : 5 - hi); // horizontal slider 'distance' (dH)
+    uint8_t dV = (vp < 0) ? 0 : (vp > JSTK_POS_CENTER ? vp - JSTK_POS_CENTER : JSTK_POS_CENTER - vp); // vertical slider 'distance'   (dV)
+    uint8_t dH = (hp < 0) ? 0 : (hp > JSTK_POS_CENTER ? hp - JSTK_POS_CENTER : JSTK_POS_CENTER - hp); // horizontal slider 'distance' (dH)
 
-    int8_t jstk_use = (dV >= dH) ? vi : hi; // slider with greatest distance wins
+    bool jstk_vert = (dV >= dH);            // slider with greatest distance wins
+    int16_t jstk_vel = jstk_vert ? jstk_motionY.vel : jstk_motionX.vel;
 
-    return jstk_ledMask(jstk_use);          // convert to bits
+    uint8_t jstk_mask = jstk_vert ? jstk_ledMask(CALIB_VERT, vp) : jstk_ledMask(CALIB_HORI, hp); // convert to bits
+    if (jstk_vel <= -CONF_FLING_SPEED)      // fast flick: light the outermost LED it is heading to
+        jstk_mask |= LED1_PIN;
+    else if (jstk_vel >= CONF_FLING_SPEED)
+        jstk_mask |= LED8_PIN;
+    return jstk_mask;
 }   // basically just prioritizes whichever axis is moving more
 
-uint8_t jstk_ledMask(int8_t idx)
+uint8_t jstk_ledMask(uint8_t axis, int8_t pos)
 {
-    if (idx < 0)    // no touch detected
+    if (pos < 0)    // no touch detected
         return 0;
 
-    if (idx == 5 || idx == 6)   // center zone
+    bool down = (pos < JSTK_POS_CENTER);
+    uint8_t off = down ? JSTK_POS_CENTER - pos : pos - JSTK_POS_CENTER;   // half-pads from center
+    if (off <= 1 || jstk_centered(axis, pos))   // middle pads, or the wider axis center snap
         return (1u<<3) | (1u<<4);  // LED4 (bit3) + LED5 (bit4)
 
-    uint8_t d = (idx < 5) ? (5 - idx) : (idx - 6);  // computes 'distance' from center (d)
+    uint8_t d = off >> 1;           // computes 'distance' from center (d)
     /*
-    idx: 0 1 2 3 4 | 5 6 | 7 8 9 10 11
-    d:   5 4 3 2 1 |  -  | 1 2 3  4  5
+    pos: 0 1 2 3 4 5 6 7 8 9 | 10 11 12 | 13 14 15 16 17 18 19 20 21 22
+    d:   5 5 4 4 3 3 2 2 1 1 |    -     |  1  1  2  2  3  3  4  4  5  5
     */
 
     uint8_t N = (d < 2 ? 2 : (d + 1));  // decide how many LED's should activate (N)
@@ -108,7 +202,7 @@ uint8_t jstk_ledMask(int8_t idx)
     */
 
     uint8_t jstk_mask = 0;
-    if (idx < 5)                            // down/left direction
+    if (down)                               // down/left direction
         for (uint8_t i = 0; i < N; i++)
             jstk_mask |= (1u << (3 - i));   // LED's 3-0
     else                                    // up/right direction
@@ -117,37 +211,99 @@ uint8_t jstk_ledMask(int8_t idx)
     return jstk_mask;
 }
 
-static uint8_t jstk_usbReport[2];
-static uint8_t jstk_prevReport[2] = {128, 128};
+#if JSTK_RPT_SIZE != UDI_HID_REPORT_IN_SIZE
+#  error "UDI_HID_REPORT_IN_SIZE in conf_usb.h must match the JSTK_RPT_* report layout"
+#endif
+#if UDI_HID_REPORT_IN_SIZE > UDI_HID_GENERIC_EP_SIZE
+#  error "the IN report must fit one interrupt packet"
+#endif
+#if KEYPAD_KEYS > JSTK_RPT_BTN_SIZE * 8
+#  error "more keys than button bits in the report"
+#endif
+
+static uint8_t jstk_prevReport[UDI_HID_REPORT_IN_SIZE] = {
+    (uint8_t)JSTK_AXIS_CENTER, JSTK_AXIS_CENTER >> 8,
+    (uint8_t)JSTK_AXIS_CENTER, JSTK_AXIS_CENTER >> 8,
+    [JSTK_RPT_X2] = 0xFF, [JSTK_RPT_Y2] = 0xFF
+};
+
+static void jstk_putAxis(uint8_t *dst, uint16_t axis) {
+    dst[0] = (uint8_t)axis;         // HID reports are little endian
+    dst[1] = (uint8_t)(axis >> 8);
+}
+
+static void jstk_putButtons(uint8_t *dst, uint32_t keys) {
+    dst[0] = (uint8_t)keys;         // key n -> button n + 1, see KEYPAD_KEY()
+    dst[1] = (uint8_t)(keys >> 8);
+    dst[2] = (uint8_t)(keys >> 16);
+}
 
 void jstk_usbTask(void)
 {
-    // sample current joystick/slider indices
-    jstk_usbReport[0] = jstk_idxToAxis(jstk_readHoriIndex());   // x
-    jstk_usbReport[1] = jstk_idxToAxis(jstk_readVertIndex());   // y
-
-    // send if value changed & IN endpoint ready
-    if ((jstk_usbReport[0] != jstk_prevReport[0]) || (jstk_usbReport[1] != jstk_prevReport[1])) { // value changed?
-        if (udi_hid_generic_send_report_in(jstk_usbReport)) {   // IN endpoint ready?
-            jstk_prevReport[0] = jstk_usbReport[0];
-            jstk_prevReport[1] = jstk_usbReport[1];
-        }
-    }
+    // sample current joystick/slider positions straight into the endpoint buffer (never a queued one)
+    uint8_t *jstk_report = udi_hid_generic_acquire_report_in();
+    jstk_putAxis(&jstk_report[JSTK_RPT_X], jstk_axisOut(CALIB_HORI, &jstk_motionX, &jstk_filterX, &jstk_releaseX, jstk_readHoriPos()));
+    jstk_putAxis(&jstk_report[JSTK_RPT_Y], jstk_axisOut(CALIB_VERT, &jstk_motionY, &jstk_filterY, &jstk_releaseY, jstk_readVertPos()));
+    jstk_putAxis(&jstk_report[JSTK_RPT_VX], (uint16_t)jstk_motionX.vel);
+    jstk_putAxis(&jstk_report[JSTK_RPT_VY], (uint16_t)jstk_motionY.vel);
+    jstk_putAxis(&jstk_report[JSTK_RPT_AX], (uint16_t)jstk_motionX.acc);
+    jstk_putAxis(&jstk_report[JSTK_RPT_AY], (uint16_t)jstk_motionY.acc);
+    jstk_report[JSTK_RPT_NX] = jstk_contactX.count;
+    jstk_report[JSTK_RPT_NY] = jstk_contactY.count;
+    jstk_report[JSTK_RPT_X2] = (uint8_t)calib_orient(CALIB_HORI, jstk_contactX.pos2);  // 0xFF = no second finger
+    jstk_report[JSTK_RPT_Y2] = (uint8_t)calib_orient(CALIB_VERT, jstk_contactY.pos2);
+    jstk_putButtons(&jstk_report[JSTK_RPT_BTN], keypad_read());
+
+    // send if value changed, at bInterval > 1 only in the frame before the host polls
+    bool jstk_send = memcmp(jstk_report, jstk_prevReport, JSTK_RPT_SIZE) != 0      // value changed?
+                  && poll_due(udd_get_frame_number());
+#ifdef CONF_SOF_MEASURE
+    irqflags_t flags = cpu_irq_save();      // latency stamp before the transfer can complete
+#endif
+    bool jstk_sent = udi_hid_generic_commit_report_in(jstk_send) && jstk_send;    // sent or queued
+    if (jstk_sent)
+        sof_sampled(jstk_now);
+#ifdef CONF_SOF_MEASURE
+    cpu_irq_restore(flags);
+#endif
+    if (jstk_sent)
+        memcpy(jstk_prevReport, jstk_report, JSTK_RPT_SIZE);    // the buffer is only read from here on
+    jstk_reportPending = (memcmp(jstk_report, jstk_prevReport, JSTK_RPT_SIZE) != 0);
 }
 
 void joystick(void) 
 {
+    bool jstk_keys = keypad_changed();              // buttons go out even while the sliders idle
+    if (!sense_due() && !jstk_keys)
+        return;                                     // idle scan rate, skip this frame
+
+    uint32_t jstk_raw;
+    sense_update(&jstk_raw);                        // one pad sample per frame
+    uint32_t jstk_new = debounce_update(&jstk_debounce, jstk_raw);
+    jstk_new = decode_stuckUpdate(&jstk_stuck, jstk_new, timebase_now());  // drop pads stuck on
+    bool jstk_changed = (jstk_new != jstk_pads);
+    jstk_pads = jstk_new;
+    sense_schedule((jstk_raw | jstk_new) & ~jstk_stuck.stuck);  // stay at full rate while anything is active
+    uint8_t jstk_mode = PORTB.IN & PIN4_bm;         // checks switch for testing mode
+    bool jstk_moving = motion_busy(&jstk_motionX) || motion_busy(&jstk_motionY)
+                    || filter_busy(&jstk_filterX) || filter_busy(&jstk_filterY)     // smoothing still settling
+                    || filter_holdBusy(&jstk_holdX) || filter_holdBusy(&jstk_holdY)
+                    || filter_releaseBusy(&jstk_releaseX) || filter_releaseBusy(&jstk_releaseY);
+
+    if (!jstk_changed && !jstk_keys && !jstk_moving && jstk_mode == jstk_testMode && !jstk_reportPending)
+        return;                             // nothing moved and nothing left to send
+
+    jstk_testMode = jstk_mode;
+
+    // transitions are stamped with the raw pad edge of their own slider, before debounce delayed them
+    jstk_now = timebase_now();
+    filter_hold(&jstk_holdX, jstk_decodeHori(), jstk_now);   // boundary flicker stays here
+    filter_hold(&jstk_holdY, jstk_decodeVert(), jstk_now);
+    motion_update(&jstk_motionX, jstk_readHoriPos(), sense_edgeStamp(SENSE_HORI), jstk_now);
+    motion_update(&jstk_motionY, jstk_readVertPos(), sense_edgeStamp(SENSE_VERT), jstk_now);
     jstk_mask = jstk_readMask();            // pick LED's
-    jstk_testMode = PORTB.IN;               // checks switch for testing mode
-
-    if ((jstk_testMode & PIN4_bm) == 0) {   // test mode
-        if (jstk_mask) {
-            led_allOff();
-            led_on(jstk_mask);
-            _delay_ms(10);
-        }
-    } else {                                // normal mode
-        led_allOff();                       // !! probably remove this later !!
+
+    led_show(jstk_testMode == 0 ? jstk_mask : 0);   // test mode shows the pads, held by led_task()
+    if (jstk_testMode != 0 || CONF_TEST_USB)
         jstk_usbTask();                     // send to USB
-    }
 }
\ No newline at end of file
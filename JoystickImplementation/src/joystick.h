@@ -3,18 +3,45 @@
 
 #include <stdint.h>
 #include "udi_hid_generic.h"
+#include "decode.h"
+
+#define JSTK_AXIS_CENTER    0x8000u     // axis value reported when not touched
+#define JSTK_POS_CENTER     (DECODE_POS_MAX / 2)    // half-pad position 11, pads 5 and 6 bridged
+
+// IN report layout (byte offsets, 16 bit fields little endian)
+#define JSTK_RPT_X          0           // horizontal position, 0-65535
+#define JSTK_RPT_Y          2           // vertical position, 0-65535
+#define JSTK_RPT_VX         4           // velocity, half-pads/s (signed)
+#define JSTK_RPT_VY         6
+#define JSTK_RPT_AX         8           // acceleration, half-pads/s^2 (signed)
+#define JSTK_RPT_AY         10
+#define JSTK_RPT_NX         12          // contacts on the slider, 8 bit
+#define JSTK_RPT_NY         13
+#define JSTK_RPT_X2         14          // second contact, half-pads 0-22, 0xFF = none (8 bit)
+#define JSTK_RPT_Y2         15
+#define JSTK_RPT_BTN        16          // keypad buttons 1-20, one bit each (bit 0 = button 1) + 4 bit padding
+#define JSTK_RPT_BTN_SIZE   3
+#define JSTK_RPT_SIZE       19
 
 
 // function prototypes
+void jstk_init(void);
 void joystick(void);
 
-int8_t jstk_readVertIndex(void);
+int8_t jstk_readVertPos(void);     // half-pad position 0-22, -1 when not touched
+int8_t jstk_readHoriPos(void);
+int8_t jstk_readVertIndex(void);   // pad index 0-11, -1 when not touched
 int8_t jstk_readHoriIndex(void);
 uint8_t jstk_readMask(void);
 
-uint8_t jstk_ledMask(int8_t percent);
-uint8_t jstk_idxToAxis(int8_t idx);
+uint8_t jstk_ledMask(uint8_t axis, int8_t pos);     // pos: half-pad position, -1 = no contact
+uint16_t jstk_posToAxis(uint8_t axis, int8_t pos);   // axis: CALIB_HORI / CALIB_VERT
+
+extern uint16_t jstk_predictLead;   // position extrapolation in timebase ticks, 0 = off
+extern uint8_t jstk_curve[2];       // response curve per axis (CALIB_HORI, CALIB_VERT), see curve.h
+extern uint8_t jstk_snap[2];        // center snap window per axis, half-pads each side of JSTK_POS_CENTER
+void jstk_setDeadzone(uint8_t axis, uint16_t width);    // axis counts each side of center
 
-void jstk_usbTask(void);	// build and send 2 byte report
+void jstk_usbTask(void);	// build and send the IN report (see JSTK_RPT_*)
 
 #endif // JOYSTICK_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+// keypad.c
+#include <asf.h>
+#include "keypad.h"
+#include "debounce.h"
+#include "conf_joystick.h"
+
+#define KEYPAD_TC       TCE0            // column step timer
+
+#define KEYPAD_ROWMASK  ((1u << KEYPAD_ROWS) - 1)
+
+volatile uint16_t keypad_ghostScans;
+
+static debounce_t keypad_debounce;      // only touched by the ISR after init
+static uint8_t keypad_col;              // column driven low right now
+static uint32_t keypad_scan;            // matrix being collected
+static volatile uint32_t keypad_keys;   // published bitmap
+static volatile bool keypad_dirty;
+
+
+// drive one column low (selected) or release it to the pull-up (wired-AND, see pinmap.h)
+#define KEYPAD_DRIVE_ITEM(n, unused) \
+    case n: \
+        if (low) PINMAP_KEYCOL_REG(n).OUTCLR = PINMAP_KEYCOL_BM(n); \
+        else     PINMAP_KEYCOL_REG(n).OUTSET = PINMAP_KEYCOL_BM(n); \
+        break;
+
+static void keypad_drive(uint8_t col, bool low) {
+    switch (col) {
+    MREPEAT(KEYPAD_COLS, KEYPAD_DRIVE_ITEM, ~)
+    }
+}
+
+// keys that can't be told apart from ghosts: rows shared by two columns, 2 or more of them
+static uint32_t keypad_ambiguous(uint32_t m) {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < KEYPAD_COLS - 1; i++) {
+        uint8_t ri = (m >> (i * KEYPAD_ROWS)) & KEYPAD_ROWMASK;
+        if ((ri & (ri - 1)) == 0)
+            continue;                   // fewer than 2 rows, can't form a rectangle
+        for (uint8_t j = i + 1; j < KEYPAD_COLS; j++) {
+            uint8_t common = ri & (m >> (j * KEYPAD_ROWS));
+            if (common & (common - 1))
+                mask |= ((uint32_t)common << (i * KEYPAD_ROWS)) | ((uint32_t)common << (j * KEYPAD_ROWS));
+        }
+    }
+    return mask;
+}
+
+// one full matrix collected
+static void keypad_frame(uint32_t matrix) {
+    uint32_t stable = debounce_update(&keypad_debounce, matrix);
+    uint32_t ambiguous = keypad_ambiguous(stable);
+    uint32_t keys = (stable & ~ambiguous) | (keypad_keys & ambiguous);
+    if (ambiguous)
+        keypad_ghostScans++;
+    if (keys != keypad_keys) {
+        keypad_keys = keys;
+        keypad_dirty = true;
+    }
+}
+
+void keypad_init(void) {
+    debounce_init(&keypad_debounce, CONF_KEYPAD_DEBOUNCE, 0);
+    keypad_col = 0;
+    keypad_scan = 0;
+    keypad_drive(0, true);              // settles until the first tick
+
+    sysclk_enable_peripheral_clock(&KEYPAD_TC);
+    KEYPAD_TC.CTRLB = TC_WGMODE_NORMAL_gc;
+    KEYPAD_TC.PER = (uint16_t)(sysclk_get_per_hz() / CONF_KEYPAD_COLUMN_HZ - 1);
+    KEYPAD_TC.INTCTRLA = TC_OVFINTLVL_LO_gc;
+    KEYPAD_TC.CTRLA = TC_CLKSEL_DIV1_gc;
+}
+
+uint32_t keypad_read(void) {
+    irqflags_t flags = cpu_irq_save();  // 32 bit copy must not tear
+    uint32_t keys = keypad_keys;
+    cpu_irq_restore(flags);
+    return keys;
+}
+
+bool keypad_changed(void) {
+    irqflags_t flags = cpu_irq_save();
+    bool dirty = keypad_dirty;
+    keypad_dirty = false;
+    cpu_irq_restore(flags);
+    return dirty;
+}
+
+
+// column step: sample the settled column, move on to the next one
+ISR(TCE0_OVF_vect)
+{
+    uint8_t col = keypad_col;
+    uint8_t rows = ~PINMAP_KEYROW_READ() & KEYPAD_ROWMASK;    // pressed keys pull their row low
+    keypad_scan |= (uint32_t)rows << (col * KEYPAD_ROWS);
+    keypad_drive(col, false);
+
+    if (++col == KEYPAD_COLS) {
+        col = 0;
+        keypad_frame(keypad_scan);
+        keypad_scan = 0;
+    }
+    keypad_drive(col, true);
+    keypad_col = col;
+}
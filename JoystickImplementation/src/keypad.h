@@ -0,0 +1,35 @@
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pinmap.h"
+
+/*
+ * Front panel keypad matrix scanner (wiring in conf_pinmap.h).
+ * A timer steps through the columns: every tick reads the rows of the column driven on the
+ * previous tick and then drives the next one, so each column settles for a full tick and
+ * nothing ever waits inside the ISR. After the last column the matrix is debounced per key
+ * and checked for ghosting, the result is one bit per key, 1 = pressed (N-key rollover).
+ *
+ * Ghosting: without diodes, three keys on the corners of a rectangle make the fourth look
+ * pressed. Whenever two columns share two or more active rows, the keys on those rows of
+ * both columns keep their previous state until the matrix is unambiguous again.
+ */
+
+#define KEYPAD_COLS         PINMAP_KEYCOLS
+#define KEYPAD_ROWS         PINMAP_KEYROW_LEN
+#define KEYPAD_KEYS         (KEYPAD_COLS * KEYPAD_ROWS)
+#define KEYPAD_KEY(col, row)    ((col) * KEYPAD_ROWS + (row))   // bit of a key in the bitmap
+
+#if KEYPAD_KEYS > 32
+#  error "keypad bitmap is 32 bit"
+#endif
+
+extern volatile uint16_t keypad_ghostScans;     // full scans where ghosting held keys back
+
+void keypad_init(void);
+uint32_t keypad_read(void);         // debounced key bitmap
+bool keypad_changed(void);          // bitmap changed since the last call
+
+#endif // KEYPAD_H
@@ -1,10 +1,18 @@
 // led.c
 #include "led.h"
 #include <asf.h>
+#include "timebase.h"
+#include "conf_joystick.h"
 
 #define LED_PORT	PORTA
 #define LED_MASK	0xFF		// PA0–PA7
 
+uint16_t led_holdTicks = TIMEBASE_MS(CONF_LED_HOLD_MS);	// minimum time a pattern stays up
+static uint8_t led_shown;		// pattern on the LED's
+static uint8_t led_next;		// pattern waiting for the hold time to pass
+static uint16_t led_since;		// timebase stamp of the last pattern change
+static bool led_held = true;	// led_shown was up for led_holdTicks
+
 void led_init(void) {
     LED_PORT.DIRSET = LED_MASK;	// outputs
     LED_PORT.OUTSET = LED_MASK;
@@ -28,4 +36,22 @@ void led_off(uint8_t mask) {	// LED off
 
 void led_toggle(uint8_t mask) {	// toggle LED
     LED_PORT.OUTTGL = mask;
-}
\ No newline at end of file
+}
+
+void led_show(uint8_t mask) {	// queue a pattern, led_task() puts it up
+	led_next = mask;
+}
+
+// LED display task, called every frame: a new pattern replaces the current one
+// once that was up for led_holdTicks, so short flickers stay readable without blocking
+void led_task(uint16_t now) {
+	if (!led_held && (uint16_t)(now - led_since) >= led_holdTicks)
+		led_held = true;		// latched, so a stamp that wrapped can't hold the display
+	if (!led_held || led_next == led_shown)
+		return;
+	LED_PORT.OUTSET = led_shown & ~led_next;
+	LED_PORT.OUTCLR = led_next;
+	led_shown = led_next;
+	led_since = now;
+	led_held = false;
+}
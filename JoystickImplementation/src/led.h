@@ -2,6 +2,7 @@
 #define LED_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // define LED's (PORTA)
 #define LED1_PIN    (1 << 0)
@@ -20,4 +21,9 @@ void led_on(uint8_t mask);
 void led_off(uint8_t mask);
 void led_toggle(uint8_t mask);
 
+// timed display, see led_task()
+extern uint16_t led_holdTicks;
+void led_show(uint8_t mask);
+void led_task(uint16_t now);
+
 #endif
\ No newline at end of file
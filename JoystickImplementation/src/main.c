@@ -41,6 +41,14 @@
 #include "led.h"
 #include "ui.h"
 #include "io.h"
+#include "tickq.h"
+#include "timebase.h"
+#include "sense.h"
+#include "joystick.h"
+#include "keypad.h"
+#include "poll.h"
+#include "sof.h"
+#include "feature.h"
 
 static volatile bool main_b_generic_enable = false;
 
@@ -69,15 +77,39 @@ int main(void)
 // 	ui_powerdown();
 
 
+	tickq_init();
+	poll_init();		// bInterval from EEPROM into the descriptor, before enumeration
+
 	// Start USB stack to authorize VBus monitoring
 	udc_start();
 
 	io_init();
 	led_init();
-
-	// main loop manages only the power mode because the USB management is done by interrupt
-	// i got rid of power mode so main loop does nothin
-	while (true) { }
+	timebase_init();
+	sof_init();
+	sense_init();
+	keypad_init();
+	jstk_init();
+
+	// USB management is done by interrupt, the SOF interrupt only starts the frame tick timer
+	// and the slider sampling/report building runs here outside of interrupt context,
+	// in between the core sleeps
+	while (true) {
+		uint16_t framenumber;
+		while (tickq_pop(&framenumber))
+			ui_process(framenumber);
+		// a latched pad edge doesn't wait for the next SOF tick
+		if (main_b_generic_enable && sense_pending())
+			ui_process(udd_get_frame_number());
+		feature_task();		// host commands write EEPROM, kept out of the USB interrupt
+
+		// sleep until the next interrupt, checked with interrupts off so no tick is slept through
+		cpu_irq_disable();
+		if (tickq_empty() && !(main_b_generic_enable && sense_pending()) && !feature_pending())
+			sleepmgr_enter_sleep();	// enables interrupts again
+		else
+			cpu_irq_enable();
+	}
 }
 
 void main_suspend_action(void)
@@ -94,7 +126,13 @@ void main_sof_action(void)
 {
 	if (!main_b_generic_enable)
 		return;
-	ui_process(udd_get_frame_number());
+	sof_start(udd_get_frame_number());	// frame tick follows sof_offset later, work is done in main loop
+}
+
+void main_report_in_sent(void)
+{
+	poll_sent(udd_get_frame_number());
+	sof_sent(timebase_now());
 }
 
 void main_remotewakeup_enable(void)
@@ -109,6 +147,7 @@ void main_remotewakeup_disable(void)
 
 bool main_generic_enable(void)
 {
+	poll_start();
 	main_b_generic_enable = true;
 	return true;
 }
@@ -118,15 +157,10 @@ void main_generic_disable(void)
 	main_b_generic_enable = false;
 }
 
-// void main_hid_set_feature(uint8_t* report)
-// {
-// 	if (report[0] == 0xAA && report[1] == 0x55
-// 			&& report[2] == 0xAA && report[3] == 0x55) {
-// 		// Disconnect USB Device
-// 		udc_stop();
-// 		ui_powerdown();
-// 	}
-// }
+void main_hid_set_feature(uint8_t* report)
+{
+	feature_received(report);	// run from the main loop, see feature.h
+}
 
 /**
  * \mainpage ASF USB Device HID Generic
@@ -53,6 +53,10 @@ void main_generic_disable(void);
  */
 void main_sof_action(void);
 
+/*! \brief Called by HID interface when the host picked up an IN report
+ */
+void main_report_in_sent(void);
+
 /*! \brief Enters the application in low power mode
  * Callback called when USB host sets USB line in suspend state
  */
@@ -72,6 +76,6 @@ void main_remotewakeup_disable(void);
 
 /*! \brief Called by UDI HID generic when USB Host send a feature request
  */
-// void main_hid_set_feature(uint8_t* report);
+void main_hid_set_feature(uint8_t* report);
 
 #endif // _MAIN_H_
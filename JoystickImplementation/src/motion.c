@@ -0,0 +1,90 @@
+// motion.c
+#include "motion.h"
+#include "timebase.h"
+
+#define MOTION_STALE    TIMEBASE_MS(MOTION_STALE_MS)
+
+static int16_t motion_clamp(int32_t v) {
+    if (v > INT16_MAX)
+        return INT16_MAX;
+    if (v < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)v;
+}
+
+void motion_init(motion_t *m) {
+    m->pos = -1;
+    m->stamp = 0;
+    m->vel = 0;
+    m->acc = 0;
+    m->rest = true;
+}
+
+void motion_update(motion_t *m, int8_t pos, uint16_t stamp, uint16_t now) {
+    if (pos != m->pos) {
+        uint16_t dt = stamp - m->stamp;
+        if (pos < 0 || m->pos < 0 || m->rest || dt >= MOTION_STALE) {
+            m->vel = 0;                 // touch down, release or starting from rest
+            m->acc = 0;
+            m->rest = (pos < 0 || m->pos < 0);  // only a move within the slider leaves rest
+        } else {
+            if (dt == 0)
+                dt = 1;
+            int16_t vel = motion_clamp((int32_t)(pos - m->pos) * (int32_t)TIMEBASE_HZ / dt);
+            // TIMEBASE_HZ / 32 keeps dv * rate inside 32 bits
+            int32_t dv = (int32_t)vel - m->vel;
+            m->acc = motion_clamp(dv * (int32_t)(TIMEBASE_HZ / 32) / dt * 32);
+            m->vel = vel;
+        }
+        m->pos = pos;
+        m->stamp = stamp;
+        return;
+    }
+
+    if (!motion_busy(m))
+        return;
+
+    uint16_t waited = now - m->stamp;
+    if (waited >= MOTION_STALE) {
+        m->vel = 0;                     // finger stopped
+        m->acc = 0;
+        m->rest = true;
+        return;
+    }
+    // no transition yet: speed is at most one half-pad per 'waited'
+    int16_t bound = motion_clamp(TIMEBASE_HZ / (waited ? waited : 1));
+    if (m->vel > bound) {
+        m->acc = 0;
+        m->vel = bound;
+    } else if (m->vel < -bound) {
+        m->acc = 0;
+        m->vel = -bound;
+    }
+}
+
+uint16_t motion_predict(const motion_t *m, uint16_t axis, int32_t step, uint16_t now, uint16_t lead) {
+    if (m->pos < 0 || m->vel == 0)
+        return axis;
+
+    if (lead > MOTION_STALE)
+        lead = MOTION_STALE;
+    uint16_t ticks = now - m->stamp;
+    ticks = (ticks < MOTION_STALE - lead) ? ticks + lead : MOTION_STALE;
+
+    // offset from the position center in 1/256 half-pad
+    int32_t offset = (int32_t)m->vel * ticks / (int32_t)(TIMEBASE_HZ / 256);
+    offset += (m->vel > 0) ? -128 : 128;            // entered at the boundary, not the center
+    if (offset > 256)
+        offset = 256;
+    if (offset < -256)
+        offset = -256;
+
+    if (m->vel < 0)
+        offset = -offset;                           // step points the way the finger moves
+    int32_t predicted = (int32_t)axis + offset * step / 256;
+    if (predicted < 0)
+        return 0;
+    if (predicted > 0xFFFF)
+        return 0xFFFF;
+    return (uint16_t)predicted;
+}
@@ -0,0 +1,47 @@
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Slider motion estimator.
+ * Every change of the half-pad position is timestamped with the timebase (TCC1),
+ * velocity and acceleration come from the time between transitions:
+ *   vel  half-pads per second
+ *   acc  half-pads per second^2
+ * Between transitions the velocity can only be as high as one half-pad over the time
+ * already waited, so it decays towards 0 and is cleared after MOTION_STALE_MS.
+ * A touch-down or MOTION_STALE_MS without a transition puts the finger at rest: the stamp
+ * is then too old for the 16 bit timebase, the next transition starts again at vel = 0.
+ */
+
+#define MOTION_STALE_MS     250         // no transition for this long = finger at rest
+
+typedef struct {
+    int8_t pos;                         // last half-pad position, -1 = no contact
+    uint16_t stamp;                     // timebase stamp of the last transition
+    int16_t vel;
+    int16_t acc;
+    bool rest;                          // m->stamp is stale, don't derive a velocity from it
+} motion_t;
+
+void motion_init(motion_t *m);
+void motion_update(motion_t *m, int8_t pos, uint16_t stamp, uint16_t now);
+
+/*
+ * Extrapolate an axis value 'lead' timebase ticks past 'now'.
+ * The finger crossed into the current position half a step before its center at m->stamp,
+ * from there it moves on at m->vel. The result never leaves the neighbouring half-pad
+ * positions, past those the next transition would have been seen.
+ * 'step' is the axis change from m->pos to the next position in the direction of travel,
+ * taken from the calibration so uneven panels extrapolate at their own pitch.
+ */
+uint16_t motion_predict(const motion_t *m, uint16_t axis, int32_t step, uint16_t now, uint16_t lead);
+
+static inline bool motion_busy(const motion_t *m) {
+    // still has to decay or to reach rest before the stamp wraps, keep updating every frame
+    return (m->vel | m->acc) != 0 || (m->pos >= 0 && !m->rest);
+}
+
+#endif // MOTION_H
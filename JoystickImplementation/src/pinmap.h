@@ -0,0 +1,68 @@
+#ifndef PINMAP_H
+#define PINMAP_H
+
+#include <mrepeat.h>
+#include "conf_pinmap.h"
+
+/*
+ * Code generated from the pin map in conf_pinmap.h.
+ * Everything folds to constants, so the read path is the same handful of
+ * port reads, shifts and masks as hand written code for the current wiring.
+ */
+
+#if PINMAP_SLIDER_GROUPS > 4
+#  error "conf_pinmap.h: at most 4 slider groups (one DMA channel each)"
+#endif
+
+#define PINMAP_PORT(letter)         ATPASTE2(PORT, letter)      // C -> PORTC
+
+// slider group n
+#define PINMAP_SLIDER(n, field)     ATPASTE3(PINMAP_SLIDER, n, field)
+#define PINMAP_SLIDER_REG(n)        PINMAP_PORT(PINMAP_SLIDER(n, _PORT))
+#define PINMAP_SLIDER_VECT(n)       ATPASTE3(PORT, PINMAP_SLIDER(n, _PORT), _INT0_vect)
+#define PINMAP_SLIDER_LOW(n)        ((1u << PINMAP_SLIDER(n, _LEN)) - 1)
+#define PINMAP_SLIDER_MASK(n)       ((uint8_t)(PINMAP_SLIDER_LOW(n) << PINMAP_SLIDER(n, _PIN)))
+
+// read every group once into v[] (raw port levels), reads are back to back
+#define PINMAP_SLIDER_READ_ITEM(n, v)   (v)[n] = PINMAP_SLIDER_REG(n).IN;
+#define PINMAP_SLIDER_READ(v)       do { MREPEAT(PINMAP_SLIDER_GROUPS, PINMAP_SLIDER_READ_ITEM, v) } while (0)
+
+// packed pad word from one byte per group, pin levels as read (1 = high)
+#define PINMAP_SLIDER_GATHER_ITEM(n, v) \
+    | ((uint32_t)(((v)[n] >> PINMAP_SLIDER(n, _PIN)) & PINMAP_SLIDER_LOW(n)) << PINMAP_SLIDER(n, _BIT))
+#define PINMAP_SLIDER_GATHER(v)     (0 MREPEAT(PINMAP_SLIDER_GROUPS, PINMAP_SLIDER_GATHER_ITEM, v))
+
+// pad pins: inputs with pull-ups, the pads pull them low (PORTCFG.MPCMASK sets all PINnCTRL at once)
+#define PINMAP_SLIDER_INIT_ITEM(n, unused) \
+    PINMAP_SLIDER_REG(n).DIRCLR = PINMAP_SLIDER_MASK(n); \
+    PORTCFG.MPCMASK = PINMAP_SLIDER_MASK(n); \
+    PINMAP_SLIDER_REG(n).PIN0CTRL = PORT_OPC_PULLUP_gc;
+#define PINMAP_SLIDER_INIT()        do { MREPEAT(PINMAP_SLIDER_GROUPS, PINMAP_SLIDER_INIT_ITEM, ~) } while (0)
+
+// keypad column n
+#define PINMAP_KEYCOL(n, field)     ATPASTE3(PINMAP_KEYCOL, n, field)
+#define PINMAP_KEYCOL_REG(n)        PINMAP_PORT(PINMAP_KEYCOL(n, _PORT))
+#define PINMAP_KEYCOL_BM(n)         ((uint8_t)(1u << PINMAP_KEYCOL(n, _PIN)))
+
+// keypad rows, PINMAP_KEYROW_READ() returns the row levels in bits 0..LEN-1 (1 = high)
+#define PINMAP_KEYROW_REG           PINMAP_PORT(PINMAP_KEYROW_PORT)
+#define PINMAP_KEYROW_LOW           ((1u << PINMAP_KEYROW_LEN) - 1)
+#define PINMAP_KEYROW_MASK          ((uint8_t)(PINMAP_KEYROW_LOW << PINMAP_KEYROW_PIN))
+#define PINMAP_KEYROW_READ()        ((uint8_t)((PINMAP_KEYROW_REG.IN >> PINMAP_KEYROW_PIN) & PINMAP_KEYROW_LOW))
+
+// columns: wired-AND with pull-up, parked high only by the pull-up (no key selected), so two
+// keys on one row never short a driven column to the selected one (no diodes in the matrix)
+// rows: inputs with pull-ups
+#define PINMAP_KEYCOL_INIT_ITEM(n, unused) \
+    PORTCFG.MPCMASK = PINMAP_KEYCOL_BM(n); \
+    PINMAP_KEYCOL_REG(n).PIN0CTRL = PORT_OPC_WIREDANDPULL_gc; \
+    PINMAP_KEYCOL_REG(n).OUTSET = PINMAP_KEYCOL_BM(n); \
+    PINMAP_KEYCOL_REG(n).DIRSET = PINMAP_KEYCOL_BM(n);
+#define PINMAP_KEYPAD_INIT() do { \
+    MREPEAT(PINMAP_KEYCOLS, PINMAP_KEYCOL_INIT_ITEM, ~) \
+    PINMAP_KEYROW_REG.DIRCLR = PINMAP_KEYROW_MASK; \
+    PORTCFG.MPCMASK = PINMAP_KEYROW_MASK; \
+    PINMAP_KEYROW_REG.PIN0CTRL = PORT_OPC_PULLUP_gc; \
+} while (0)
+
+#endif // PINMAP_H
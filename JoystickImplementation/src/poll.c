@@ -0,0 +1,52 @@
+// poll.c
+#include <asf.h>
+#include "poll.h"
+#include "conf_joystick.h"
+
+#define POLL_UNKNOWN    0xFF    // no IN transfer completed yet
+
+uint8_t poll_interval = UDI_HID_GENERIC_EP_INTERVAL;
+uint8_t poll_lead = CONF_POLL_LEAD_FRAMES;
+static uint8_t poll_stored = UDI_HID_GENERIC_EP_INTERVAL;   // interval in the descriptor
+static volatile uint8_t poll_phase = POLL_UNKNOWN;          // frame number of the last poll & (interval - 1)
+
+static bool poll_valid(uint8_t ms) {
+    return ms == 1 || ms == 2 || ms == 4 || ms == 8;
+}
+
+void poll_init(void) {
+    uint8_t rec[3];
+    nvm_eeprom_read_buffer(CONF_POLL_EEPROM_ADDR, rec, sizeof(rec));
+    if (rec[0] == POLL_MAGIC && (uint8_t)(rec[1] ^ rec[2]) == 0xFF && poll_valid(rec[1]))
+        poll_stored = rec[1];       // blank or corrupt EEPROM keeps the build default
+    udi_hid_generic_set_interval(poll_stored);
+}
+
+bool poll_set(uint8_t ms) {
+    if (!poll_valid(ms))
+        return false;
+    if (ms != poll_stored) {
+        uint8_t rec[3] = { POLL_MAGIC, ms, (uint8_t)~ms };
+        nvm_eeprom_erase_and_write_buffer(CONF_POLL_EEPROM_ADDR, rec, sizeof(rec));
+        poll_stored = ms;
+        udi_hid_generic_set_interval(ms);   // the host reads it when it enumerates again
+    }
+    return true;
+}
+
+void poll_start(void) {
+    poll_interval = poll_stored;    // what the host got with this configuration
+    poll_phase = POLL_UNKNOWN;
+}
+
+void poll_sent(uint16_t framenumber) {
+    poll_phase = (uint8_t)framenumber & (poll_interval - 1);
+}
+
+bool poll_due(uint16_t framenumber) {
+    uint8_t phase = poll_phase;
+    if (poll_interval == 1 || phase == POLL_UNKNOWN)
+        return true;                // every frame is polled, or phase still to be learned
+    // frame numbers wrap at 2048, a multiple of every interval
+    return (((uint8_t)framenumber + poll_lead - phase) & (poll_interval - 1)) == 0;
+}
@@ -0,0 +1,27 @@
+#ifndef POLL_H
+#define POLL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Interrupt IN polling interval (bInterval, 1/2/4/8 ms) and report phase.
+ * The interval is read from EEPROM at boot (build default UDI_HID_GENERIC_EP_INTERVAL)
+ * and patched into the RAM configuration descriptor before udc_start().
+ * The frame of every completed IN transfer gives the host's poll phase, reports
+ * are then only queued poll_lead frames ahead of the next poll so they leave fresh:
+ * 1 when the frame tick comes before the host's IN token, 0 when it comes after (see sof.h).
+ */
+
+#define POLL_MAGIC      0x5A    // stored as magic, interval, ~interval
+
+extern uint8_t poll_interval;   // interval of the current enumeration (ms)
+extern uint8_t poll_lead;       // frames between queueing a report and the poll, 0 or 1
+
+void poll_init(void);                   // before udc_start()
+bool poll_set(uint8_t ms);              // store and patch, used from the next enumeration on
+void poll_start(void);                  // interface enabled by the host
+void poll_sent(uint16_t framenumber);   // IN transfer done (USB interrupt)
+bool poll_due(uint16_t framenumber);    // queue the report in this frame?
+
+#endif // POLL_H
@@ -0,0 +1,302 @@
+// sense.c
+#include <asf.h>
+#include "sense.h"
+#include "timebase.h"
+#include "pinmap.h"
+#include "conf_joystick.h"
+
+// slider pins come from conf_pinmap.h (set up by io_init(), ISC left at both edges)
+#define SENSE_PORTS     PINMAP_SLIDER_GROUPS    // one byte plane per pin group
+
+#define SENSE_TC        TCC0            // oversampling timer
+
+static enum sense_mode sense_mode;
+static volatile uint32_t sense_latched;    // pad word captured by the pin-change ISR
+static volatile uint16_t sense_stamp[SENSE_AXES];  // last change per slider
+static volatile bool sense_dirty;          // latched but not fetched yet
+static uint32_t sense_last;                // last word handed out by sense_update()
+static volatile uint8_t sense_ring[SENSE_PORTS][SENSE_OVERSAMPLE];
+static volatile uint8_t sense_ringIdx;
+
+// DMA capture: two banks of the same layout, one filled by the DMA while the other is read
+static volatile uint8_t sense_dmaBuf[2][SENSE_PORTS][SENSE_OVERSAMPLE];
+static volatile uint8_t sense_dmaBank;     // bank the DMA is filling
+static volatile uint8_t sense_dmaReady;    // last completed bank
+
+// adaptive scan rate
+static bool sense_idle;                     // running CONF_SENSE_IDLE_MODE
+static uint16_t sense_quietFrames;          // processed frames without any pad active
+static uint8_t sense_idleDiv;               // frame divider for the slow idle poll
+
+
+// PORTx.IN of every group, for the DMA source addresses
+#define SENSE_IN_ITEM(n, unused)    &PINMAP_SLIDER_REG(n).IN,
+static volatile uint8_t *const sense_portIn[SENSE_PORTS] = {
+    MREPEAT(SENSE_PORTS, SENSE_IN_ITEM, ~)
+};
+
+static uint32_t sense_pack(const uint8_t *ports) {
+    return ~PINMAP_SLIDER_GATHER(ports) & SENSE_PAD_MASK;  // pads are active low
+}
+
+static uint32_t sense_readPorts(void) {
+    uint8_t ports[SENSE_PORTS];
+    PINMAP_SLIDER_READ(ports);
+    return sense_pack(ports);
+}
+
+/*
+ * Per-bit majority over the SENSE_OVERSAMPLE snapshots of one port.
+ * Bit-sliced: c0..c3 are the bit planes of a 4 bit "pin was high" count per pin.
+ * A pin reads high (pad released) when at least half of the samples were high,
+ * so a pad only counts as touched when the clear majority of samples were low.
+ */
+static uint8_t sense_majority(const volatile uint8_t *samples) {
+    uint8_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    for (uint8_t i = 0; i < SENSE_OVERSAMPLE; i++) {
+        uint8_t carry = samples[i];
+        uint8_t t = c0 & carry; c0 ^= carry; carry = t;     // ripple add one per set bit
+        t = c1 & carry; c1 ^= carry; carry = t;
+        t = c2 & carry; c2 ^= carry;
+        c3 |= t;
+    }
+    return c3 | c2;     // count >= 4 of 8
+}
+
+// stamp only the slider whose pads changed, the other one keeps its own edge
+static void sense_stampEdges(uint32_t was, uint32_t now, uint16_t stamp) {
+    uint32_t diff = was ^ now;
+    if ((diff >> SENSE_VERT_SHIFT) & SENSE_AXIS_MASK)
+        sense_stamp[SENSE_VERT] = stamp;
+    if ((diff >> SENSE_HORI_SHIFT) & SENSE_AXIS_MASK)
+        sense_stamp[SENSE_HORI] = stamp;
+}
+
+static uint32_t sense_reduce(void) {
+    uint8_t copy[SENSE_PORTS][SENSE_OVERSAMPLE];
+    irqflags_t flags = cpu_irq_save();      // snapshot the ring in one piece
+    for (uint8_t p = 0; p < SENSE_PORTS; p++)
+        for (uint8_t i = 0; i < SENSE_OVERSAMPLE; i++)
+            copy[p][i] = sense_ring[p][i];
+    cpu_irq_restore(flags);
+    uint8_t ports[SENSE_PORTS];
+    for (uint8_t p = 0; p < SENSE_PORTS; p++)
+        ports[p] = sense_majority(copy[p]);
+    return sense_pack(ports);
+}
+
+static uint32_t sense_reduceDma(void) {
+    const volatile uint8_t (*bank)[SENSE_OVERSAMPLE] = sense_dmaBuf[sense_dmaReady];
+    uint8_t ports[SENSE_PORTS];
+    for (uint8_t p = 0; p < SENSE_PORTS; p++)
+        ports[p] = sense_majority(bank[p]);
+    return sense_pack(ports);
+}   // the DMA is busy with the other bank, no copy needed
+
+// prefill so the first reductions don't see stale samples
+static void sense_fill(volatile uint8_t (*planes)[SENSE_OVERSAMPLE]) {
+    uint8_t ports[SENSE_PORTS];
+    PINMAP_SLIDER_READ(ports);
+    for (uint8_t p = 0; p < SENSE_PORTS; p++)
+        for (uint8_t i = 0; i < SENSE_OVERSAMPLE; i++)
+            planes[p][i] = ports[p];
+}
+
+// TCC0 paces both the oversampling ISR and the DMA trigger event
+static void sense_timer(bool run, bool irq) {
+    SENSE_TC.CTRLA = TC_CLKSEL_OFF_gc;
+    SENSE_TC.INTCTRLA = irq ? TC_OVFINTLVL_LO_gc : TC_OVFINTLVL_OFF_gc;
+    if (!run)
+        return;
+    SENSE_TC.CTRLB = TC_WGMODE_NORMAL_gc;
+    SENSE_TC.PER = (uint16_t)(sysclk_get_per_hz() / CONF_SENSE_OVERSAMPLE_HZ - 1);
+    SENSE_TC.CNT = 0;
+    SENSE_TC.CTRLA = TC_CLKSEL_DIV1_gc;
+}
+
+// the last group always lands on CH3: lowest priority, finishes last
+static DMA_CH_t *sense_dmaChannel(uint8_t port) {
+    return &(&DMA.CH0)[4 - SENSE_PORTS + port];
+}
+
+static void sense_dmaArm(uint8_t bank) {
+    for (uint8_t p = 0; p < SENSE_PORTS; p++) {
+        DMA_CH_t *ch = sense_dmaChannel(p);
+        uint16_t dst = (uint16_t)sense_dmaBuf[bank][p];
+        ch->DESTADDR0 = (uint8_t)dst;
+        ch->DESTADDR1 = (uint8_t)(dst >> 8);
+        ch->DESTADDR2 = 0;
+        ch->TRFCNT = SENSE_OVERSAMPLE;
+        ch->CTRLA |= DMA_CH_ENABLE_bm;
+    }
+}
+
+/*
+ * One DMA channel per slider port, all triggered by TCC0 overflow through event channel 0.
+ * Every trigger moves one PORTx.IN byte per channel into the current bank,
+ * after SENSE_OVERSAMPLE triggers CH3 interrupts and the channels are re-armed on the other bank.
+ */
+static void sense_dma(bool enable) {
+    for (uint8_t p = 0; p < SENSE_PORTS; p++) {
+        sense_dmaChannel(p)->CTRLA = 0;     // stop, also drops a half done block
+        sense_dmaChannel(p)->CTRLB = DMA_CH_TRNIF_bm | DMA_CH_ERRIF_bm;
+    }
+    if (!enable)
+        return;
+
+    DMA.CTRL = DMA_ENABLE_bm | DMA_PRIMODE_CH0123_gc;  // fixed priority CH0 > CH3
+    EVSYS.CH0MUX = EVSYS_CHMUX_TCC0_OVF_gc;
+
+    for (uint8_t p = 0; p < SENSE_PORTS; p++) {
+        DMA_CH_t *ch = sense_dmaChannel(p);
+        uint16_t src = (uint16_t)sense_portIn[p];
+        ch->ADDRCTRL = DMA_CH_SRCRELOAD_NONE_gc | DMA_CH_SRCDIR_FIXED_gc
+                     | DMA_CH_DESTRELOAD_NONE_gc | DMA_CH_DESTDIR_INC_gc;
+        ch->TRIGSRC = DMA_CH_TRIGSRC_EVSYS_CH0_gc;
+        ch->SRCADDR0 = (uint8_t)src;
+        ch->SRCADDR1 = (uint8_t)(src >> 8);
+        ch->SRCADDR2 = 0;
+        ch->CTRLB = (p == SENSE_PORTS - 1) ? DMA_CH_TRNINTLVL_LO_gc : 0;
+        ch->CTRLA = DMA_CH_SINGLE_bm | DMA_CH_BURSTLEN_1BYTE_gc;   // one byte per trigger
+    }
+
+    sense_fill(sense_dmaBuf[0]);
+    sense_fill(sense_dmaBuf[1]);
+    sense_dmaReady = 1;
+    sense_dmaBank = 0;
+    sense_dmaArm(0);
+}
+
+#define SENSE_INTMASK_ITEM(n, on)   PINMAP_SLIDER_REG(n).INT0MASK = (on) ? PINMAP_SLIDER_MASK(n) : 0;
+#define SENSE_INTCTRL_ITEM(n, lvl)  PINMAP_SLIDER_REG(n).INTCTRL = (lvl);
+#define SENSE_INTCLR_ITEM(n, unused) PINMAP_SLIDER_REG(n).INTFLAGS = PORT_INT0IF_bm;
+
+static void sense_pinChange(bool enable) {
+    MREPEAT(SENSE_PORTS, SENSE_INTMASK_ITEM, enable)
+}
+
+void sense_init(void) {
+    sysclk_enable_peripheral_clock(&SENSE_TC);
+    sysclk_enable_peripheral_clock(&DMA);
+    sysclk_enable_peripheral_clock(&EVSYS);
+    MREPEAT(SENSE_PORTS, SENSE_INTCTRL_ITEM, PORT_INT0LVL_LO_gc)
+    sense_setMode(CONF_SENSE_MODE);
+}
+
+void sense_setMode(enum sense_mode mode) {
+    irqflags_t flags = cpu_irq_save();
+    sense_mode = mode;
+    // drop stale edges, then take a fresh snapshot so nothing in between is lost
+    MREPEAT(SENSE_PORTS, SENSE_INTCLR_ITEM, ~)
+    sense_pinChange(mode == SENSE_MODE_PINCHANGE);
+    sense_timer(false, false);
+    sense_dma(mode == SENSE_MODE_DMA);
+    if (mode == SENSE_MODE_OVERSAMPLE)
+        sense_fill(sense_ring);
+    sense_timer(mode == SENSE_MODE_OVERSAMPLE || mode == SENSE_MODE_DMA, mode == SENSE_MODE_OVERSAMPLE);
+    sense_latched = sense_readPorts();
+    sense_stampEdges(0, SENSE_PAD_MASK, timebase_now());
+    sense_dirty = true;
+    cpu_irq_restore(flags);
+}
+
+bool sense_update(uint32_t *pads) {
+    uint32_t now;
+    if (sense_mode == SENSE_MODE_PINCHANGE) {
+        irqflags_t flags = cpu_irq_save();  // 32 bit copy must not tear
+        now = sense_latched;
+        sense_dirty = false;
+        cpu_irq_restore(flags);
+    } else {
+        now = (sense_mode == SENSE_MODE_DMA) ? sense_reduceDma()
+            : (sense_mode == SENSE_MODE_OVERSAMPLE) ? sense_reduce() : sense_readPorts();
+        sense_dirty = false;
+        if (now != sense_last)
+            sense_stampEdges(sense_last, now, timebase_now());
+    }
+
+    bool changed = (now != sense_last);
+    sense_last = now;
+    *pads = now;
+    return changed;
+}
+
+/*
+ * Adaptive scan rate.
+ * After CONF_SENSE_IDLE_MS frames without contact the acquisition drops to CONF_SENSE_IDLE_MODE:
+ * pure pin-change wake, or a slow poll every CONF_SENSE_IDLE_PERIOD frames.
+ * The first active pad switches straight back to the full rate CONF_SENSE_MODE.
+ */
+bool sense_due(void) {
+    if (!sense_idle || sense_dirty)
+        return true;                        // full rate, or an edge woke us up
+    if (CONF_SENSE_IDLE_MODE == SENSE_MODE_PINCHANGE)
+        return false;                       // nothing to do until the next edge
+    if (++sense_idleDiv < CONF_SENSE_IDLE_PERIOD)
+        return false;
+    sense_idleDiv = 0;
+    return true;
+}
+
+void sense_schedule(uint32_t pads) {
+    if (pads) {
+        sense_quietFrames = 0;
+        if (sense_idle) {                   // first contact, ramp up
+            sense_idle = false;
+            sense_setMode(CONF_SENSE_MODE);
+        }
+    } else if (!sense_idle && ++sense_quietFrames >= CONF_SENSE_IDLE_MS) {
+        sense_idle = true;
+        sense_idleDiv = 0;
+        sense_setMode(CONF_SENSE_IDLE_MODE);
+    }
+}
+
+bool sense_pending(void) {
+    return sense_dirty;
+}
+
+uint16_t sense_edgeStamp(enum sense_axis axis) {
+    irqflags_t flags = cpu_irq_save();
+    uint16_t stamp = sense_stamp[axis];
+    cpu_irq_restore(flags);
+    return stamp;
+}
+
+
+/*
+ * Pin-change on any slider pin: timestamp and latch the whole pad word.
+ * Flags are cleared before the ports are read, so an edge arriving after
+ * the read re-triggers the interrupt instead of being lost.
+ */
+static inline void sense_pinIsr(void)
+{
+    MREPEAT(SENSE_PORTS, SENSE_INTCLR_ITEM, ~)
+    uint32_t pads = sense_readPorts();
+    sense_stampEdges(sense_latched, pads, timebase_now());
+    sense_latched = pads;
+    sense_dirty = true;
+}
+#define SENSE_ISR_ITEM(n, unused)   ISR(PINMAP_SLIDER_VECT(n)) { sense_pinIsr(); }
+MREPEAT(SENSE_PORTS, SENSE_ISR_ITEM, ~)
+
+
+// oversampling tick: store one raw snapshot of every slider port
+#define SENSE_RING_ITEM(n, idx)     sense_ring[n][idx] = PINMAP_SLIDER_REG(n).IN;
+ISR(TCC0_OVF_vect)
+{
+    uint8_t i = sense_ringIdx;
+    MREPEAT(SENSE_PORTS, SENSE_RING_ITEM, i)
+    sense_ringIdx = (i + 1) & (SENSE_OVERSAMPLE - 1);
+}
+
+
+// DMA block complete (CH3 is served last): hand the bank over and continue on the other one
+ISR(DMA_CH3_vect)
+{
+    DMA.CH3.CTRLB = DMA_CH_TRNIF_bm | DMA_CH_TRNINTLVL_LO_gc;
+    uint8_t done = sense_dmaBank;
+    sense_dmaArm(done ^ 1);
+    sense_dmaBank = done ^ 1;
+    sense_dmaReady = done;
+}
@@ -0,0 +1,41 @@
+#ifndef SENSE_H
+#define SENSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Slider pad acquisition.
+ * All 24 slider pads are packed into one word, 1 = pad touched:
+ *   bits  0-11  vertical slider   (C2-C7, D0-D5)
+ *   bits 12-23  horizontal slider (E0-E7, B0-B3)
+ */
+#define SENSE_VERT_SHIFT    0
+#define SENSE_HORI_SHIFT    12
+#define SENSE_AXIS_MASK     0x0FFFu
+#define SENSE_PAD_MASK      0x00FFFFFFUL
+
+enum sense_axis {
+    SENSE_VERT,
+    SENSE_HORI,
+    SENSE_AXES,
+};
+
+#define SENSE_OVERSAMPLE    8           // snapshots per reduction (power of 2, max 8)
+
+enum sense_mode {
+    SENSE_MODE_POLL,            // ports are read on every sense_update()
+    SENSE_MODE_PINCHANGE,       // ports are read by the pin-change ISR on every edge
+    SENSE_MODE_OVERSAMPLE,      // TCC0 fills a ring of snapshots, sense_update() takes the majority
+    SENSE_MODE_DMA,             // TCC0 events let the DMA copy the ports, CPU only sees full blocks
+};
+
+void sense_init(void);
+void sense_setMode(enum sense_mode mode);
+bool sense_update(uint32_t *pads);  // latest pad word, true if it changed since the last call
+bool sense_pending(void);           // an edge was latched that sense_update() has not fetched yet
+bool sense_due(void);               // call once per frame, false if the idle scan rate skips it
+void sense_schedule(uint32_t pads); // feed back the pads of a sampled frame to pick the scan rate
+uint16_t sense_edgeStamp(enum sense_axis axis);    // timebase stamp of the last pad change on that slider
+
+#endif // SENSE_H
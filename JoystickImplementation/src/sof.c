@@ -0,0 +1,74 @@
+// sof.c
+#include <asf.h>
+#include "sof.h"
+#include "tickq.h"
+#include "conf_joystick.h"
+
+#define SOF_TC          TCD1
+
+#if CONF_SOF_OFFSET_US >= 1000
+#  error "CONF_SOF_OFFSET_US must be shorter than a frame"
+#endif
+
+uint16_t sof_offset = SOF_TICKS(CONF_SOF_OFFSET_US);
+static volatile uint16_t sof_frame;     // frame number latched at the SOF
+
+void sof_init(void) {
+    sysclk_enable_peripheral_clock(&SOF_TC);
+    SOF_TC.CTRLA = TC_CLKSEL_OFF_gc;
+    SOF_TC.CTRLB = TC_WGMODE_NORMAL_gc;
+    SOF_TC.INTCTRLA = TC_OVFINTLVL_LO_gc;
+}
+
+void sof_start(uint16_t framenumber) {
+    if (sof_offset == 0) {
+        tickq_post(framenumber);
+        return;
+    }
+    sof_frame = framenumber;
+    SOF_TC.CTRLA = TC_CLKSEL_OFF_gc;    // resync, a tick still running from the last frame is dropped
+    SOF_TC.CNT = 0;
+    SOF_TC.PER = sof_offset - 1;        // overflow after sof_offset ticks
+    SOF_TC.INTFLAGS = TC1_OVFIF_bm;
+    SOF_TC.CTRLA = TC_CLKSEL_DIV8_gc;
+}
+
+ISR(TCD1_OVF_vect) {
+    SOF_TC.CTRLA = TC_CLKSEL_OFF_gc;    // one shot
+    tickq_post(sof_frame);
+}
+
+#ifdef CONF_SOF_MEASURE
+volatile uint16_t sof_latency;
+volatile uint16_t sof_latencyAvg;
+volatile uint16_t sof_latencyMax;
+static volatile uint16_t sof_sampleStamp;   // report in the endpoint
+static volatile uint16_t sof_pendingStamp;  // report in the mailbox, armed on the next completion
+static volatile bool sof_inFlight;
+static volatile bool sof_pending;
+
+void sof_sampled(uint16_t stamp) {
+    irqflags_t flags = cpu_irq_save();
+    if (sof_inFlight) {
+        sof_pendingStamp = stamp;   // latest wins, as in the mailbox
+        sof_pending = true;
+    } else {
+        sof_sampleStamp = stamp;
+        sof_inFlight = true;
+    }
+    cpu_irq_restore(flags);
+}
+
+void sof_sent(uint16_t stamp) {
+    if (!sof_inFlight)
+        return;
+    uint16_t lat = stamp - sof_sampleStamp;
+    sof_inFlight = sof_pending;     // the mailbox goes out next
+    sof_sampleStamp = sof_pendingStamp;
+    sof_pending = false;
+    sof_latency = lat;
+    sof_latencyAvg += (int16_t)(lat - sof_latencyAvg) / 16;
+    if (lat > sof_latencyMax)
+        sof_latencyMax = lat;
+}
+#endif
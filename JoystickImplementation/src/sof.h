@@ -0,0 +1,37 @@
+#ifndef SOF_H
+#define SOF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "conf_joystick.h"
+
+/*
+ * SOF-phase frame tick: the SOF interrupt restarts a one shot on TCD1 and the frame tick
+ * is posted when it expires, sof_offset after the SOF, so sampling, filtering and loading
+ * the IN endpoint finish just ahead of the host's IN token instead of right after the SOF.
+ * Timer clock is clk_per / 8 = 1.5 MHz, 0.67 us per tick, the offset must stay below a frame.
+ *
+ * With CONF_SOF_MEASURE defined, every completed IN transfer records how long ago the
+ * slider sample it carries was taken (timebase ticks, 5.33 us). The stamps follow the
+ * one report in transfer plus the mailbox.
+ */
+
+#define SOF_TICKS(us)   ((uint16_t)(((uint32_t)(us) * 3) / 2))     // microseconds to timer ticks
+
+extern uint16_t sof_offset;     // timer ticks from SOF to the frame tick, 0 = tick in the SOF interrupt
+
+void sof_init(void);
+void sof_start(uint16_t framenumber);   // SOF interrupt
+
+#ifdef CONF_SOF_MEASURE
+extern volatile uint16_t sof_latency;       // sample to transfer of the last report
+extern volatile uint16_t sof_latencyAvg;    // running average (1/16 weight)
+extern volatile uint16_t sof_latencyMax;
+void sof_sampled(uint16_t stamp);           // report with this sample posted to the endpoint
+void sof_sent(uint16_t stamp);              // IN transfer done (USB interrupt)
+#else
+static inline void sof_sampled(uint16_t stamp) { (void)stamp; }
+static inline void sof_sent(uint16_t stamp) { (void)stamp; }
+#endif
+
+#endif // SOF_H
@@ -0,0 +1,39 @@
+// tickq.c
+#include "tickq.h"
+
+#define TICKQ_MASK  (TICKQ_SIZE - 1)
+
+static volatile uint16_t tickq_buf[TICKQ_SIZE];
+static volatile uint8_t tickq_head;     // written by the producer only
+static volatile uint8_t tickq_tail;     // written by the consumer only
+volatile uint8_t tickq_overruns;        // ticks dropped because the main loop fell behind
+
+void tickq_init(void) {
+    tickq_head = 0;
+    tickq_tail = 0;
+    tickq_overruns = 0;
+}
+
+bool tickq_post(uint16_t framenumber) {
+    uint8_t head = tickq_head;
+    if ((uint8_t)(head - tickq_tail) >= TICKQ_SIZE) {  // full
+        tickq_overruns++;
+        return false;
+    }
+    tickq_buf[head & TICKQ_MASK] = framenumber;
+    tickq_head = head + 1;          // publish only after the slot is written
+    return true;
+}
+
+bool tickq_pop(uint16_t *framenumber) {
+    uint8_t tail = tickq_tail;
+    if (tail == tickq_head)         // empty
+        return false;
+    *framenumber = tickq_buf[tail & TICKQ_MASK];
+    tickq_tail = tail + 1;          // hand the slot back to the producer
+    return true;
+}
+
+bool tickq_empty(void) {
+    return tickq_tail == tickq_head;
+}
@@ -0,0 +1,20 @@
+#ifndef TICKQ_H
+#define TICKQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Lock-free single-producer/single-consumer queue of frame ticks.
+ * The SOF interrupt is the only producer, the main loop the only consumer,
+ * so head and tail are each written from one side only and no IRQ masking is needed.
+ */
+
+#define TICKQ_SIZE  8               // must be a power of 2
+
+void tickq_init(void);
+bool tickq_post(uint16_t framenumber);  // ISR side, false if the queue was full
+bool tickq_pop(uint16_t *framenumber);  // main loop side, false if empty
+bool tickq_empty(void);
+
+#endif // TICKQ_H
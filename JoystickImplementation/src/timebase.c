@@ -0,0 +1,21 @@
+// timebase.c
+#include <asf.h>
+#include "timebase.h"
+
+#define TIMEBASE_TC     TCC1
+
+void timebase_init(void) {
+    sysclk_enable_peripheral_clock(&TIMEBASE_TC);
+    TIMEBASE_TC.CTRLB = TC_WGMODE_NORMAL_gc;
+    TIMEBASE_TC.PER = 0xFFFF;                   // full 16 bit range, no interrupt
+    TIMEBASE_TC.CNT = 0;
+    TIMEBASE_TC.CTRLA = TC_CLKSEL_DIV64_gc;     // 12 MHz / 64
+}
+
+uint16_t timebase_now(void) {
+    // 16 bit reads go through the shared TEMP register, keep ISRs out
+    irqflags_t flags = cpu_irq_save();
+    uint16_t now = TIMEBASE_TC.CNT;
+    cpu_irq_restore(flags);
+    return now;
+}
@@ -0,0 +1,19 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+/*
+ * Free-running 16 bit timestamp counter on TCC1.
+ * clk_per (12 MHz) / 64 = 187.5 kHz, one tick = 5.33 us, wraps every ~350 ms.
+ * Differences of two stamps are valid as long as they are less than one wrap apart.
+ */
+
+#define TIMEBASE_HZ             187500UL
+#define TIMEBASE_US(us)         ((uint16_t)(((uint32_t)(us) * 3) / 16))    // microseconds to ticks
+#define TIMEBASE_MS(ms)         ((uint16_t)(((uint32_t)(ms) * 375) / 2))   // milliseconds to ticks (ms < 350)
+
+void timebase_init(void);
+uint16_t timebase_now(void);
+
+#endif // TIMEBASE_H
@@ -1,9 +1,12 @@
 #include <asf.h>
 #include "ui.h"
 #include "joystick.h"
+#include "led.h"
+#include "timebase.h"
 
 
-// called every Start-Of-Frame (1 ms) when interface is enabled
+// called from the main loop for every Start-Of-Frame tick (1 ms) when interface is enabled
 void ui_process(uint16_t framenumber) {
     joystick();
+    led_task(timebase_now());
 }
\ No newline at end of file
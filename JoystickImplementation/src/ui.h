@@ -40,6 +40,8 @@
 
 /*! \brief This process is called each 1ms
  * It is called only if the USB interface is enabled.
+ * It runs from the main loop (not from the SOF interrupt) for each tick
+ * posted by main_sof_action().
  */
 void ui_process(uint16_t framenumber);
 
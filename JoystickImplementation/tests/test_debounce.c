@@ -0,0 +1,107 @@
+// test_debounce.c - debounce_update() against recorded pad words, depths 1-8
+#include <stdio.h>
+#include <stdlib.h>
+#include "debounce.h"
+
+// pad words as sampled by sense.c (1 = touched), one per frame:
+// a finger landing on pads 5/6 with contact bounce, sliding to 7 and lifting
+static const uint32_t rec_slide[] = {
+    0x000000, 0x000020, 0x000000, 0x000020, 0x000060, 0x000020, 0x000060, 0x000060,
+    0x000060, 0x000060, 0x0000E0, 0x000060, 0x0000E0, 0x0000C0, 0x0000C0, 0x0000C0,
+    0x000080, 0x0000C0, 0x000080, 0x000080, 0x000080, 0x000080, 0x000000, 0x000080,
+    0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+};
+// both sliders, a noisy pad (bit 17) and a short glitch across the horizontal panel
+static const uint32_t rec_noise[] = {
+    0x000000, 0x020000, 0x000000, 0x020000, 0x020000, 0x000000, 0x020000, 0x020000,
+    0x020000, 0x7FF000, 0x000000, 0x021000, 0x023000, 0x021000, 0x023000, 0x023000,
+    0x023000, 0x023000, 0x023000, 0x022000, 0x023000, 0x022000, 0x022000, 0x022000,
+    0x022000, 0x022000, 0x002000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000,
+};
+
+static int failures;
+
+// reference: one counter per bit, flip after 'depth' disagreeing samples in a row
+typedef struct {
+    uint32_t state;
+    uint8_t cnt[32];
+} ref_t;
+
+static uint32_t ref_update(ref_t *r, uint32_t sample, uint8_t depth) {
+    for (uint8_t b = 0; b < 32; b++) {
+        if (((sample ^ r->state) >> b) & 1) {
+            if (++r->cnt[b] >= depth) {
+                r->state ^= 1UL << b;
+                r->cnt[b] = 0;
+            }
+        } else {
+            r->cnt[b] = 0;
+        }
+    }
+    return r->state;
+}
+
+static void check_trace(const char *name, const uint32_t *words, unsigned n, uint8_t depth) {
+    debounce_t db;
+    ref_t ref = { 0, { 0 } };
+    debounce_init(&db, depth, 0);
+    for (unsigned i = 0; i < n; i++) {
+        uint32_t got = debounce_update(&db, words[i]);
+        uint32_t want = ref_update(&ref, words[i], depth);
+        if (got != want) {
+            printf("FAIL %s depth %u sample %u: 0x%06lX, expected 0x%06lX\n",
+                   name, depth, i, (unsigned long)got, (unsigned long)want);
+            failures++;
+            return;
+        }
+    }
+    // the pads released at the end: settled once 'depth' more quiet samples are in
+    for (uint8_t i = 0; i < depth; i++) {
+        ref_update(&ref, 0, depth);
+        debounce_update(&db, 0);
+    }
+    if (debounce_busy(&db) || db.state != 0) {
+        printf("FAIL %s depth %u: still counting after a quiet tail\n", name, depth);
+        failures++;
+    }
+}
+
+// a clean edge flips on exactly the depth-th sample, one sample less never flips
+static void check_depth(uint8_t depth) {
+    debounce_t db;
+    debounce_init(&db, depth, 0);
+    for (uint8_t i = 1; i <= depth; i++) {
+        uint32_t out = debounce_update(&db, 0x000001);
+        if ((i < depth && out != 0) || (i == depth && out != 0x000001)) {
+            printf("FAIL depth %u: edge seen after %u samples\n", depth, i);
+            failures++;
+            return;
+        }
+    }
+    debounce_init(&db, depth, 0);
+    for (uint8_t i = 1; i < depth; i++)
+        debounce_update(&db, 0x000001);
+    debounce_update(&db, 0);
+    if (depth > 1 && debounce_update(&db, 0x000001) != 0) {
+        printf("FAIL depth %u: a bounce did not restart the count\n", depth);
+        failures++;
+    }
+}
+
+int main(void) {
+    for (uint8_t depth = 1; depth <= DEBOUNCE_DEPTH_MAX; depth++) {
+        check_depth(depth);
+        check_trace("slide", rec_slide, sizeof(rec_slide) / sizeof(rec_slide[0]), depth);
+        check_trace("noise", rec_noise, sizeof(rec_noise) / sizeof(rec_noise[0]), depth);
+    }
+    // random words hit every counter state on all 32 bits
+    srand(1);
+    for (uint8_t depth = 1; depth <= DEBOUNCE_DEPTH_MAX; depth++) {
+        static uint32_t words[4096];
+        for (unsigned i = 0; i < 4096; i++)
+            words[i] = (rand() & 1) ? ((uint32_t)rand() << 16 ^ (uint32_t)rand()) : words[i ? i - 1 : 0];
+        check_trace("random", words, 4096, depth);
+    }
+    printf("debounce: %s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}